@@ -26,7 +26,7 @@ public:
      * @param i2cBus I2C bus number (e.g., 0, 1)
      * @param i2cAddress 7-bit I2C device address
      */
-    I2CSensor(uint8_t id, const std::string& name, uint8_t i2cBus, uint8_t i2cAddress);
+    I2CSensor(SensorId id, const std::string& name, uint8_t i2cBus, uint8_t i2cAddress);
     
     /**
      * @brief Destructor
@@ -41,11 +41,11 @@ public:
     bool initialize() override;
     
     /**
-     * @brief Read data from the I2C sensor
+     * @brief Read raw data from the I2C sensor
      * 
-     * @return SensorReading object containing the measured values
+     * @return SensorReading object containing the uncalibrated values
      */
-    SensorReading read() override;
+    SensorReading readRaw() override;
     
     /**
      * @brief Calibrate the I2C sensor
@@ -75,6 +75,13 @@ public:
      */
     bool selfTest() override;
     
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * @return "i2c-<bus>"
+     */
+    std::string getBusKey() const override;
+    
     /**
      * @brief Write data to I2C register
      * 
@@ -14,8 +14,17 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "../config.h"
 #include "../system/error_handler.h"
+#include "../system/logger.h"
+#include "../system/metrics_registry.h"
+#include "calibration.h"
+#include "sensor_registry.h"
+
+namespace System {
+class LatencyTracer;
+} // namespace System
 
 namespace Sensors {
 
@@ -37,13 +46,16 @@ struct SensorReading {
     uint64_t timestamp;         ///< Timestamp of the reading in milliseconds
     std::vector<float> values;  ///< Measured values 
     std::string unit;           ///< Unit of measurement
-    uint8_t sensorId;           ///< Unique identifier for the sensor
+    SensorId sensorId;          ///< Unique identifier for the sensor
     bool valid;                 ///< Flag indicating if the reading is valid
+    uint32_t traceId;           ///< Latency trace ID, 0 if the reading is not traced
+    uint64_t journalLsn;        ///< Write-ahead journal LSN, 0 if the reading is not journaled
     
-    SensorReading() : timestamp(0), values(), unit(""), sensorId(0), valid(false) {}
+    SensorReading()
+        : timestamp(0), values(), unit(""), sensorId(0), valid(false), traceId(0), journalLsn(0) {}
     
-    SensorReading(uint64_t ts, const std::vector<float>& vals, const std::string& u, uint8_t id, bool v = true)
-        : timestamp(ts), values(vals), unit(u), sensorId(id), valid(v) {}
+    SensorReading(uint64_t ts, const std::vector<float>& vals, const std::string& u, SensorId id, bool v = true)
+        : timestamp(ts), values(vals), unit(u), sensorId(id), valid(v), traceId(0), journalLsn(0) {}
 };
 
 /**
@@ -54,10 +66,12 @@ public:
     /**
      * @brief Constructor
      * 
+     * Registers the ID with the SensorRegistry.
+     * 
      * @param id Unique sensor identifier
      * @param name Human-readable name of the sensor
      */
-    SensorBase(uint8_t id, const std::string& name);
+    SensorBase(SensorId id, const std::string& name);
     
     /**
      * @brief Virtual destructor
@@ -72,15 +86,28 @@ public:
     virtual bool initialize() = 0;
     
     /**
-     * @brief Read data from the sensor
+     * @brief Read data from the sensor and apply its calibration
+     * 
+     * Holds the bus mutex around readRaw(), then corrects valid readings
+     * with the calibration snapshot current at that moment, so drivers
+     * return raw values and need no correction code of their own. With a
+     * tracer set, valid readings are passed to LatencyTracer::begin()
+     * last, which stamps ACQUIRED for the sampled ones.
+     * Invalid readings are logged with LOG_EVERY_N at WARNING, once per
+     * LOG_HOT_PATH_EVERY_N, with the sensor ID and last error.
      * 
-     * @return SensorReading object containing the measured values
+     * @return SensorReading object containing the calibrated values
      */
-    virtual SensorReading read() = 0;
+    SensorReading read();
     
     /**
      * @brief Calibrate the sensor
      * 
+     * May run on the deferred-work thread while acquisition calls read().
+     * Implementations sample with sampleRaw(), never read(), and hold
+     * getBusMutex() only around each individual bus transaction, so
+     * acquisition on the bus keeps running between samples.
+     * 
      * @return true if calibration successful, false otherwise
      */
     virtual bool calibrate() = 0;
@@ -102,6 +129,8 @@ public:
     /**
      * @brief Self-test the sensor
      * 
+     * Same locking rules as calibrate().
+     * 
      * @return true if self-test passed, false otherwise
      */
     virtual bool selfTest() = 0;
@@ -114,6 +143,62 @@ public:
      */
     virtual bool setSamplingRate(uint32_t rateMs);
     
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * Sensors with the same key are brought up one after another,
+     * sensors with different keys in parallel.
+     * 
+     * @return Bus key, e.g. "i2c-1"; empty if the sensor has no shared bus
+     */
+    virtual std::string getBusKey() const;
+    
+    /**
+     * @brief Get the lock serializing transactions on the sensor's bus
+     * 
+     * Sensors with the same non-empty bus key share one mutex from a
+     * process-wide table; a sensor without a shared bus gets its own.
+     * It is held for one bus transaction at a time: read() holds it around
+     * readRaw(), sampleRaw() likewise, and drivers around each other
+     * transaction in calibrate() and selfTest(). It is not recursive, so
+     * code holding it must not call read() or sampleRaw().
+     * 
+     * @return Bus mutex
+     */
+    std::mutex& getBusMutex();
+    
+    /**
+     * @brief Start latency traces in read()
+     * 
+     * Set on every sensor that feeds the pipeline, together with
+     * DataProcessor::setTracer() and CommManager::attachTracer(), before
+     * acquisition starts.
+     * 
+     * @param tracer Latency tracer, or nullptr to disable
+     */
+    void setTracer(std::shared_ptr<System::LatencyTracer> tracer);
+    
+    /**
+     * @brief Set the calibration applied by read()
+     * 
+     * Drivers call this from calibrate(), possibly on the deferred
+     * calibration thread; the startup orchestrator calls it with cached
+     * data on warm restarts. The data is copied into a new immutable
+     * snapshot and published with an atomic pointer swap, so a
+     * concurrent read() applies either the old or the new calibration,
+     * never a mix.
+     * 
+     * @param calibration Calibration data
+     */
+    void setCalibration(const CalibrationData& calibration);
+    
+    /**
+     * @brief Get the current calibration
+     * 
+     * @return Calibration snapshot, identity if never calibrated
+     */
+    std::shared_ptr<const CalibrationData> getCalibration() const;
+    
     /**
      * @brief Get the current sensor state
      * 
@@ -126,7 +211,14 @@ public:
      * 
      * @return Sensor ID
      */
-    uint8_t getId() const;
+    SensorId getId() const;
+    
+    /**
+     * @brief Get the dense index of the sensor
+     * 
+     * @return Index into per-sensor tables, INVALID_SENSOR_INDEX if the registry was full
+     */
+    SensorIndex getIndex() const;
     
     /**
      * @brief Get the sensor name
@@ -150,12 +242,39 @@ public:
     bool isValid() const;
 
 protected:
-    uint8_t mId;                     ///< Unique sensor identifier
+    SensorId mId;                    ///< Unique sensor identifier
+    SensorIndex mIndex;              ///< Dense index assigned by the SensorRegistry
     std::string mName;               ///< Human-readable name
     SensorState mState;              ///< Current state of the sensor
     uint32_t mSamplingRateMs;        ///< Sampling rate in milliseconds
     System::ErrorCode mLastError;    ///< Last error that occurred
     bool mIsValid;                   ///< Indicates if the sensor is operational
+    std::shared_ptr<const CalibrationData> mCalibration; ///< Swapped with std::atomic_store
+    std::shared_ptr<std::mutex> mBusMutex; ///< Resolved from getBusKey() on first use
+    std::shared_ptr<System::LatencyTracer> mTracer; ///< Optional, begin() is called by read()
+    System::Counter mReadsMetric;    ///< sensor_reads_total{sensor="<id>"}
+    System::Counter mReadErrorsMetric; ///< sensor_read_errors_total{sensor="<id>"}
+    System::Histogram mReadDurationMetric; ///< sensor_read_duration_us, one histogram shared by all sensors
+    
+    /**
+     * @brief Read uncalibrated data from the hardware
+     * 
+     * Implemented by drivers; called by read() and sampleRaw() with the
+     * bus mutex held.
+     * 
+     * @return SensorReading object containing the raw values
+     */
+    virtual SensorReading readRaw() = 0;
+    
+    /**
+     * @brief Take one raw sample for calibrate() or selfTest()
+     * 
+     * Holds the bus mutex for the single readRaw() call only; applies no
+     * calibration and updates no read metrics.
+     * 
+     * @return SensorReading object containing the raw values
+     */
+    SensorReading sampleRaw();
     
     /**
      * @brief Set the sensor state
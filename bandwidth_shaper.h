@@ -0,0 +1,196 @@
+/**
+ * @file bandwidth_shaper.h
+ * @brief Token-bucket rate limiting of uplink traffic
+ * 
+ * This file provides token buckets and a shaper that enforces a global
+ * and per-topic uplink budget in bytes/s and messages/s, while keeping
+ * a reserved share of the global budget for control-plane traffic.
+ */
+
+#ifndef BANDWIDTH_SHAPER_H
+#define BANDWIDTH_SHAPER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include "../config.h"
+
+namespace Communication {
+
+enum class MessagePriority;
+
+/**
+ * @brief Bandwidth budget
+ * 
+ * A rate of 0 means unlimited.
+ */
+struct BandwidthBudget {
+    uint32_t bytesPerSec;     ///< Sustained byte rate
+    uint32_t messagesPerSec;  ///< Sustained message rate
+    uint32_t burstBytes;      ///< Byte bucket depth
+    uint32_t burstMessages;   ///< Message bucket depth
+    
+    BandwidthBudget()
+        : bytesPerSec(0), messagesPerSec(0), burstBytes(0), burstMessages(0) {}
+    
+    BandwidthBudget(uint32_t bps, uint32_t mps, uint32_t bb, uint32_t bm)
+        : bytesPerSec(bps), messagesPerSec(mps), burstBytes(bb), burstMessages(bm) {}
+};
+
+/**
+ * @brief Shaper counters
+ */
+struct ShaperStats {
+    uint64_t sentBytes;          ///< Bytes admitted
+    uint64_t sentMessages;       ///< Messages admitted
+    uint64_t deferredBytes;      ///< Bytes deferred because the budget was exhausted
+    uint64_t deferredMessages;   ///< Messages deferred because the budget was exhausted
+    uint64_t reserveBytes;       ///< Bytes admitted from the control-plane reserve
+    
+    ShaperStats()
+        : sentBytes(0), sentMessages(0), deferredBytes(0), deferredMessages(0), reserveBytes(0) {}
+};
+
+/**
+ * @brief Token bucket
+ */
+class TokenBucket {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param ratePerSec Refill rate in tokens per second (0 = unlimited)
+     * @param depth Bucket depth in tokens
+     */
+    TokenBucket(uint32_t ratePerSec = 0, uint32_t depth = 0);
+    
+    /**
+     * @brief Change the rate and depth, keeping the current fill level
+     * 
+     * @param ratePerSec Refill rate in tokens per second (0 = unlimited)
+     * @param depth Bucket depth in tokens
+     */
+    void configure(uint32_t ratePerSec, uint32_t depth);
+    
+    /**
+     * @brief Take tokens if at least floor + amount are available
+     * 
+     * @param amount Tokens to take
+     * @param nowMs Current time in milliseconds
+     * @param floor Tokens that must remain after taking
+     * @return true if taken, false otherwise
+     */
+    bool tryConsume(uint32_t amount, uint64_t nowMs, uint32_t floor = 0);
+    
+    /**
+     * @brief Take tokens unconditionally, allowing the bucket to go negative
+     * 
+     * @param amount Tokens to take
+     * @param nowMs Current time in milliseconds
+     */
+    void forceConsume(uint32_t amount, uint64_t nowMs);
+    
+    /**
+     * @brief Get the time until the given amount becomes available
+     * 
+     * @param amount Tokens needed
+     * @param nowMs Current time in milliseconds
+     * @return Wait time in milliseconds
+     */
+    uint32_t waitTimeMs(uint32_t amount, uint64_t nowMs);
+
+private:
+    uint32_t mRatePerSec;
+    uint32_t mDepth;
+    int64_t mTokensMilli;    ///< Fill level in thousandths of a token
+    uint64_t mLastRefillMs;
+    
+    /**
+     * @brief Add tokens accrued since the last refill
+     * 
+     * @param nowMs Current time in milliseconds
+     */
+    void refill(uint64_t nowMs);
+};
+
+/**
+ * @brief Bandwidth shaper class
+ * 
+ * CRITICAL messages are always admitted and drive the buckets into
+ * debt. HIGH messages may use the control reserve of the global byte
+ * budget; NORMAL and LOW messages must leave it untouched, so a backlog
+ * drain cannot starve status updates and error reports.
+ */
+class BandwidthShaper {
+public:
+    /**
+     * @brief Constructor
+     */
+    BandwidthShaper();
+    
+    /**
+     * @brief Destructor
+     */
+    ~BandwidthShaper();
+    
+    /**
+     * @brief Set the global uplink budget
+     * 
+     * @param budget Budget
+     * @param controlReservePercent Share of the byte budget reserved for HIGH priority
+     */
+    void setGlobalBudget(const BandwidthBudget& budget, uint8_t controlReservePercent);
+    
+    /**
+     * @brief Set the budget for a single topic
+     * 
+     * @param topic Topic
+     * @param budget Budget
+     */
+    void setTopicBudget(const std::string& topic, const BandwidthBudget& budget);
+    
+    /**
+     * @brief Ask to send a message now
+     * 
+     * @param topic Topic of the message
+     * @param bytes Message size in bytes
+     * @param priority Message priority
+     * @param nowMs Current time in milliseconds
+     * @return true if admitted, false if it must be deferred
+     */
+    bool admit(const std::string& topic, uint32_t bytes, MessagePriority priority, uint64_t nowMs);
+    
+    /**
+     * @brief Get the time until a deferred message could be admitted
+     * 
+     * @param topic Topic of the message
+     * @param bytes Message size in bytes
+     * @param nowMs Current time in milliseconds
+     * @return Wait time in milliseconds
+     */
+    uint32_t waitTimeMs(const std::string& topic, uint32_t bytes, uint64_t nowMs);
+    
+    /**
+     * @brief Get shaper counters
+     * 
+     * @return Shaper counters
+     */
+    ShaperStats getStats() const;
+
+private:
+    struct Buckets {
+        TokenBucket bytes;
+        TokenBucket messages;
+    };
+    
+    Buckets mGlobal;
+    uint32_t mReserveBytes;
+    std::map<std::string, Buckets> mTopics;
+    ShaperStats mStats;
+    mutable std::mutex mMutex;
+};
+
+} // namespace Communication
+
+#endif // BANDWIDTH_SHAPER_H
@@ -0,0 +1,146 @@
+/**
+ * @file bounded_queue.h
+ * @brief Lock-free bounded queue
+ * 
+ * This file provides a fixed-capacity, allocation-free queue based on
+ * per-cell sequence numbers (D. Vyukov's bounded MPMC algorithm). It is
+ * safe for any number of producers and consumers and is used both as a
+ * multi-producer/single-consumer hand-off and as a lock-free free list.
+ */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace System {
+
+/**
+ * @brief Lock-free bounded multi-producer/multi-consumer queue
+ * 
+ * @tparam T Element type, must be default constructible and movable
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param capacity Requested capacity, rounded up to a power of two
+     */
+    explicit BoundedQueue(size_t capacity)
+        : mCapacity(roundUpPowerOfTwo(capacity)),
+          mMask(mCapacity - 1),
+          mCells(new Cell[mCapacity]),
+          mEnqueuePos(0),
+          mDequeuePos(0) {
+        for (size_t i = 0; i < mCapacity; ++i) {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+    
+    /**
+     * @brief Try to enqueue an element
+     * 
+     * @param value Element to enqueue
+     * @return true if enqueued, false if the queue is full
+     */
+    bool tryPush(T value) {
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &mCells[pos & mMask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Try to dequeue an element
+     * 
+     * @param value Reference to store the dequeued element
+     * @return true if dequeued, false if the queue is empty
+     */
+    bool tryPop(T& value) {
+        size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &mCells[pos & mMask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->data);
+        cell->sequence.store(pos + mCapacity, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Get the approximate number of queued elements
+     * 
+     * @return Number of elements, exact only when the queue is quiescent
+     */
+    size_t sizeApprox() const {
+        size_t enq = mEnqueuePos.load(std::memory_order_relaxed);
+        size_t deq = mDequeuePos.load(std::memory_order_relaxed);
+        return enq > deq ? enq - deq : 0;
+    }
+    
+    /**
+     * @brief Get the queue capacity
+     * 
+     * @return Capacity
+     */
+    size_t capacity() const { return mCapacity; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+    
+    static size_t roundUpPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    const size_t mCapacity;
+    const size_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+    alignas(64) std::atomic<size_t> mEnqueuePos;
+    alignas(64) std::atomic<size_t> mDequeuePos;
+};
+
+} // namespace System
+
+#endif // BOUNDED_QUEUE_H
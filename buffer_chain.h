@@ -0,0 +1,248 @@
+/**
+ * @file buffer_chain.h
+ * @brief Pooled buffer chains for zero-copy payload handling
+ * 
+ * This file provides reference-counted buffer segments from a fixed
+ * pool and a chain type that serialization, encryption and the socket
+ * write all operate on, so a payload is written once and handed to the
+ * kernel as an iovec array.
+ */
+
+#ifndef BUFFER_CHAIN_H
+#define BUFFER_CHAIN_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/uio.h>
+#include "../config.h"
+#include "../system/bounded_queue.h"
+
+namespace Communication {
+
+class BufferPool;
+
+/**
+ * @brief Buffer segment
+ * 
+ * The usable region is data[offset, offset + length); bytes before
+ * offset are headroom for headers prepended later.
+ */
+struct BufferSegment {
+    char* data;                   ///< Start of the segment memory
+    uint32_t capacity;            ///< Size of the segment memory
+    uint32_t offset;              ///< Start of the valid data
+    uint32_t length;              ///< Length of the valid data
+    std::atomic<uint32_t> refs;   ///< Number of chains referencing the segment
+    BufferPool* pool;             ///< Owning pool
+    
+    BufferSegment() : data(nullptr), capacity(0), offset(0), length(0), refs(0), pool(nullptr) {}
+};
+
+/**
+ * @brief Payload copy counters
+ */
+struct PayloadCopyStats {
+    uint64_t messages;       ///< Messages published
+    uint64_t payloadBytes;   ///< Payload bytes published
+    uint64_t copies;         ///< Payload copies made after serialization
+    uint64_t bytesCopied;    ///< Bytes copied after serialization
+    uint64_t zeroCopySends;  ///< Sends that used MSG_ZEROCOPY
+    
+    PayloadCopyStats()
+        : messages(0), payloadBytes(0), copies(0), bytesCopied(0), zeroCopySends(0) {}
+};
+
+/**
+ * @brief Fixed pool of buffer segments
+ * 
+ * All segment memory is allocated up front; acquire and release are
+ * lock-free.
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param segmentSize Size of each segment in bytes
+     * @param segmentCount Number of segments
+     */
+    BufferPool(
+        size_t segmentSize = DeviceConfig::BUFFER_SEGMENT_SIZE,
+        size_t segmentCount = DeviceConfig::BUFFER_SEGMENT_COUNT
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~BufferPool();
+    
+    /**
+     * @brief Take a segment from the pool
+     * 
+     * @param headroom Bytes to leave free at the front
+     * @return Segment with one reference, or nullptr if exhausted
+     */
+    BufferSegment* acquire(uint32_t headroom = 0);
+    
+    /**
+     * @brief Drop a reference, returning the segment when it reaches zero
+     * 
+     * @param segment Segment to release
+     */
+    void release(BufferSegment* segment);
+    
+    /**
+     * @brief Get the number of free segments
+     * 
+     * @return Free segment count
+     */
+    size_t available() const;
+
+private:
+    size_t mSegmentSize;
+    std::unique_ptr<char[]> mMemory;
+    std::unique_ptr<BufferSegment[]> mSegments;
+    System::BoundedQueue<BufferSegment*> mFree;
+};
+
+/**
+ * @brief Chain of buffer segments forming one payload
+ * 
+ * Move-only; share() adds references to the same segments so a payload
+ * can be published on several connections without copying. A chain has
+ * no length limit of its own: it grows for as long as the pool supplies
+ * segments.
+ */
+class BufferChain {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param pool Pool to draw segments from
+     * @param headroom Headroom to reserve in the first segment
+     */
+    explicit BufferChain(BufferPool* pool = nullptr, uint32_t headroom = 0);
+    
+    /**
+     * @brief Destructor, releases all segments
+     */
+    ~BufferChain();
+    
+    BufferChain(BufferChain&& other) noexcept;
+    BufferChain& operator=(BufferChain&& other) noexcept;
+    BufferChain(const BufferChain&) = delete;
+    BufferChain& operator=(const BufferChain&) = delete;
+    
+    /**
+     * @brief Append bytes, acquiring segments as needed
+     * 
+     * @param data Bytes to append
+     * @param length Number of bytes
+     * @return false if the pool is exhausted
+     */
+    bool append(const char* data, size_t length);
+    
+    /**
+     * @brief Get writable space at the tail, acquiring a segment if full
+     * 
+     * Lets serializers format directly into the chain; follow with commit().
+     * 
+     * @param minLength Minimum contiguous space needed
+     * @param length Reference to store the available space
+     * @return Pointer to the space, or nullptr if exhausted
+     */
+    char* prepare(size_t minLength, size_t& length);
+    
+    /**
+     * @brief Commit bytes written into space returned by prepare()
+     * 
+     * @param length Number of bytes written
+     */
+    void commit(size_t length);
+    
+    /**
+     * @brief Claim headroom in front of the first segment
+     * 
+     * @param length Number of bytes to prepend
+     * @return Pointer to the claimed bytes, or nullptr if headroom is insufficient
+     */
+    char* prepend(size_t length);
+    
+    /**
+     * @brief Create another chain referencing the same segments
+     * 
+     * @return Shared chain
+     */
+    BufferChain share() const;
+    
+    /**
+     * @brief Release all segments
+     */
+    void clear();
+    
+    /**
+     * @brief Fill an iovec array describing part of the chain
+     * 
+     * A chain may have more segments than one writev() accepts (IOV_MAX);
+     * callers write it in batches, passing the index after the last
+     * segment of the previous batch.
+     * 
+     * @param iov Array to fill
+     * @param maxIov Array capacity
+     * @param firstSegment Index of the first segment to describe
+     * @return Number of entries used
+     */
+    size_t toIovec(struct iovec* iov, size_t maxIov, size_t firstSegment = 0) const;
+    
+    /**
+     * @brief Copy the chain into a contiguous string
+     * 
+     * For legacy paths only; counted as a copy in PayloadCopyStats.
+     * 
+     * @return Payload as a string
+     */
+    std::string flatten() const;
+    
+    /**
+     * @brief Get the number of segments
+     * 
+     * @return Segment count
+     */
+    size_t segmentCount() const;
+    
+    /**
+     * @brief Get a segment
+     * 
+     * @param index Segment index
+     * @return Segment
+     */
+    BufferSegment* segment(size_t index) const;
+    
+    /**
+     * @brief Get the total payload length
+     * 
+     * @return Length in bytes
+     */
+    size_t size() const;
+    
+    /**
+     * @brief Check if the chain is empty
+     * 
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+private:
+    BufferPool* mPool;
+    uint32_t mHeadroom;
+    std::vector<BufferSegment*> mSegments;
+    size_t mLength;
+};
+
+} // namespace Communication
+
+#endif // BUFFER_CHAIN_H
@@ -0,0 +1,218 @@
+/**
+ * @file calibration.h
+ * @brief Sensor calibration model and on-disk cache
+ * 
+ * This file provides per-channel calibration data (offset, gain and an
+ * optional polynomial), a vectorizable transform that applies it in the
+ * read path, and a compact checksummed cache so calibration survives
+ * restarts.
+ * 
+ * Cache file layout (little endian), one file per sensor:
+ * 
+ *   | magic "CALB" (4) | version (2) | channelCount (1) | sensorId (4) |
+ *   | timestamp (8) | nameHash (4) | channels... | crc32 (4) |
+ * 
+ * Channel layout: | offset (4) | gain (4) | degree (1) | coefficients (4 * (degree + 1)) |
+ * 
+ * Files with another version, sensor or name hash, or a bad CRC are ignored.
+ */
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "sensor_registry.h"
+
+namespace Sensors {
+
+/**
+ * @brief Calibration of a single channel
+ * 
+ * The corrected value is gain * raw + offset, followed by the polynomial
+ * c[0] + c[1] * x + ... + c[degree] * x^degree when degree > 0.
+ */
+struct ChannelCalibration {
+    static constexpr uint8_t MAX_POLY_DEGREE = 5;
+    
+    float offset;                                 ///< Additive offset
+    float gain;                                   ///< Multiplicative gain
+    uint8_t degree;                               ///< Polynomial degree, 0 for affine only
+    float coefficients[MAX_POLY_DEGREE + 1];      ///< Polynomial coefficients, lowest order first
+    
+    ChannelCalibration() : offset(0.0f), gain(1.0f), degree(0), coefficients() {}
+};
+
+/**
+ * @brief Calibration of a sensor
+ * 
+ * Offsets and gains are also kept as contiguous arrays so the affine
+ * part of the transform compiles to SIMD multiply-adds.
+ */
+class CalibrationData {
+public:
+    static constexpr uint16_t FORMAT_VERSION = 2;
+    
+    /**
+     * @brief Constructor, identity calibration
+     */
+    CalibrationData();
+    
+    /**
+     * @brief Set the calibration of one channel
+     * 
+     * @param channel Channel index
+     * @param calibration Channel calibration
+     */
+    void setChannel(size_t channel, const ChannelCalibration& calibration);
+    
+    /**
+     * @brief Get the calibration of one channel
+     * 
+     * @param channel Channel index
+     * @return Channel calibration, identity if not set
+     */
+    ChannelCalibration getChannel(size_t channel) const;
+    
+    /**
+     * @brief Get the number of calibrated channels
+     * 
+     * @return Channel count
+     */
+    size_t channelCount() const;
+    
+    /**
+     * @brief Check if the calibration is the identity
+     * 
+     * @return true if no channel is calibrated, false otherwise
+     */
+    bool isIdentity() const;
+    
+    /**
+     * @brief Apply the calibration to a set of values in place
+     * 
+     * Channels beyond channelCount() are left untouched.
+     * 
+     * @param values Values to correct
+     * @param count Number of values
+     */
+    void apply(float* values, size_t count) const {
+        size_t n = count < mGains.size() ? count : mGains.size();
+        const float* __restrict gains = mGains.data();
+        const float* __restrict offsets = mOffsets.data();
+        float* __restrict v = values;
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = v[i] * gains[i] + offsets[i];
+        }
+        if (mHasPolynomial) {
+            for (size_t i = 0; i < n; ++i) {
+                const ChannelCalibration& channel = mChannels[i];
+                if (channel.degree == 0) {
+                    continue;
+                }
+                float result = channel.coefficients[channel.degree];
+                for (int k = channel.degree - 1; k >= 0; --k) {
+                    result = result * v[i] + channel.coefficients[k];
+                }
+                v[i] = result;
+            }
+        }
+    }
+    
+    /**
+     * @brief Serialize to the cache file format
+     * 
+     * @param sensorId Sensor identifier
+     * @param sensorName Sensor name, hashed to detect a swapped sensor
+     * @param out Buffer to store the encoded bytes
+     */
+    void encode(SensorId sensorId, const std::string& sensorName, std::vector<uint8_t>& out) const;
+    
+    /**
+     * @brief Parse the cache file format
+     * 
+     * @param data Encoded bytes
+     * @param length Number of bytes
+     * @param sensorId Expected sensor identifier
+     * @param sensorName Expected sensor name
+     * @return false on version, identity or checksum mismatch
+     */
+    bool decode(const uint8_t* data, size_t length, SensorId sensorId, const std::string& sensorName);
+    
+    /**
+     * @brief Get the time the calibration was taken
+     * 
+     * @return Timestamp in milliseconds
+     */
+    uint64_t getTimestamp() const;
+    
+    /**
+     * @brief Set the time the calibration was taken
+     * 
+     * @param timestamp Timestamp in milliseconds
+     */
+    void setTimestamp(uint64_t timestamp);
+
+private:
+    std::vector<ChannelCalibration> mChannels;
+    std::vector<float> mGains;      ///< Gain per channel, contiguous
+    std::vector<float> mOffsets;    ///< Offset per channel, contiguous
+    bool mHasPolynomial;
+    uint64_t mTimestamp;
+};
+
+/**
+ * @brief On-disk calibration cache class
+ */
+class CalibrationCache {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param directory Cache directory
+     */
+    explicit CalibrationCache(const std::string& directory = DeviceConfig::CALIBRATION_CACHE_PATH);
+    
+    /**
+     * @brief Load the cached calibration of a sensor
+     * 
+     * @param sensorId Sensor identifier
+     * @param sensorName Sensor name
+     * @param maxAgeMs Maximum age of a usable entry
+     * @param nowMs Current time in milliseconds
+     * @param data Reference to store the calibration
+     * @return true if a valid, fresh entry was found, false otherwise
+     */
+    bool load(SensorId sensorId, const std::string& sensorName, uint64_t maxAgeMs,
+              uint64_t nowMs, CalibrationData& data) const;
+    
+    /**
+     * @brief Store the calibration of a sensor
+     * 
+     * Writes a temporary file, syncs it and renames it into place.
+     * 
+     * @param sensorId Sensor identifier
+     * @param sensorName Sensor name
+     * @param data Calibration to store
+     * @return true if successful, false otherwise
+     */
+    bool store(SensorId sensorId, const std::string& sensorName, const CalibrationData& data) const;
+    
+    /**
+     * @brief Remove the cached calibration of a sensor
+     * 
+     * @param sensorId Sensor identifier
+     * @return true if removed or not present, false on error
+     */
+    bool invalidate(SensorId sensorId) const;
+
+private:
+    std::string mDirectory;
+};
+
+} // namespace Sensors
+
+#endif // CALIBRATION_H
@@ -0,0 +1,367 @@
+/**
+ * @file coap_client.h
+ * @brief CoAP client implementation for IoT communication
+ * 
+ * This file provides a Constrained Application Protocol (RFC 7252)
+ * client over UDP, with block-wise transfer (RFC 7959) for large
+ * payloads and observe (RFC 7641) for server-pushed commands.
+ */
+
+#ifndef COAP_CLIENT_H
+#define COAP_CLIENT_H
+
+#include <string>
+#include <functional>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "../config.h"
+#include "../system/error_handler.h"
+#include "tls_context.h"
+
+namespace Communication {
+
+/**
+ * @brief CoAP message types
+ */
+enum class CoAPMessageType {
+    CONFIRMABLE = 0,      ///< Retransmitted until acknowledged (CON)
+    NON_CONFIRMABLE = 1,  ///< Fire and forget (NON)
+    ACKNOWLEDGEMENT = 2,  ///< Acknowledges a CON message (ACK)
+    RESET = 3             ///< Rejects a message (RST)
+};
+
+/**
+ * @brief CoAP request methods
+ */
+enum class CoAPMethod {
+    GET = 1,
+    POST = 2,
+    PUT = 3,
+    DELETE = 4
+};
+
+/**
+ * @brief CoAP content formats used by the firmware
+ */
+enum class CoAPContentFormat {
+    TEXT_PLAIN = 0,
+    OCTET_STREAM = 42,
+    JSON = 50,
+    CBOR = 60
+};
+
+/**
+ * @brief Block sizes for block-wise transfer (SZX encoding)
+ */
+enum class CoAPBlockSize {
+    BLOCK_16 = 0,
+    BLOCK_32 = 1,
+    BLOCK_64 = 2,
+    BLOCK_128 = 3,
+    BLOCK_256 = 4,
+    BLOCK_512 = 5,
+    BLOCK_1024 = 6
+};
+
+/**
+ * @brief CoAP client states
+ */
+enum class CoAPClientState {
+    STOPPED,
+    RUNNING,
+    ERROR
+};
+
+/**
+ * @brief CoAP notification callback type
+ * 
+ * Called with the resource path and the payload of each observe notification.
+ */
+using CoAPObserveCallback = std::function<void(const std::string&, const std::string&)>;
+
+/**
+ * @brief CoAP completion callback type
+ * 
+ * Called on the receive thread with the exchange ID returned by
+ * sendAsync() and whether the exchange succeeded (NON sent, or CON and
+ * every block acknowledged).
+ */
+using CoAPCompletionCallback = std::function<void(uint32_t, bool)>;
+
+/**
+ * @brief DTLS credentials of the CoAP client
+ * 
+ * A pre-shared key is used when psk is set; otherwise the handshake
+ * authenticates with the certificates of tlsContext, the context the
+ * MQTT connections share.
+ */
+struct DTLSCredentials {
+    std::string pskIdentity;                 ///< PSK identity sent to the server
+    std::vector<uint8_t> psk;                ///< Pre-shared key, empty for certificates
+    std::shared_ptr<TLSContext> tlsContext;  ///< CA and client certificates
+    
+    DTLSCredentials() : pskIdentity(), psk(), tlsContext() {}
+};
+
+/**
+ * @brief CoAP client class
+ */
+class CoAPClient {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param server CoAP server address
+     * @param port CoAP server port, 5683 for plain CoAP
+     * @param useDtls Whether to use DTLS
+     * @param credentials DTLS credentials, required when useDtls is set
+     */
+    CoAPClient(
+        const std::string& server,
+        uint16_t port = DeviceConfig::COAP_PORT,
+        bool useDtls = DeviceConfig::COAP_USE_DTLS,
+        const DTLSCredentials& credentials = DTLSCredentials()
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~CoAPClient();
+    
+    /**
+     * @brief Initialize the CoAP client and open the UDP socket
+     * 
+     * With DTLS, performs the handshake and fails if the credentials
+     * hold neither a PSK nor a TLS context.
+     * 
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize();
+    
+    /**
+     * @brief Start the receive/retransmission thread
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool start();
+    
+    /**
+     * @brief Stop the receive/retransmission thread and cancel observations
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool stop();
+    
+    /**
+     * @brief Send a payload to a resource
+     * 
+     * NON messages return as soon as the datagram is sent. CON messages
+     * block until acknowledged or until MAX_RETRANSMIT retransmissions
+     * with exponential backoff have failed. Payloads larger than the
+     * configured block size are sent with Block1 transfer.
+     * 
+     * @param path Resource path (e.g. "telemetry")
+     * @param payload Message payload
+     * @param type CONFIRMABLE or NON_CONFIRMABLE
+     * @param method Request method
+     * @param format Content format
+     * @return true if sent (NON) or acknowledged (CON), false otherwise
+     */
+    bool send(
+        const std::string& path,
+        const std::string& payload,
+        CoAPMessageType type = CoAPMessageType::NON_CONFIRMABLE,
+        CoAPMethod method = CoAPMethod::POST,
+        CoAPContentFormat format = CoAPContentFormat::JSON
+    );
+    
+    /**
+     * @brief Send a payload without waiting for acknowledgement
+     * 
+     * Sends the first datagram (or first block) and returns. Retransmissions
+     * and the remaining blocks are driven by the receive thread, which calls
+     * the completion callback when the exchange finishes. NON exchanges
+     * complete as soon as the last datagram is sent.
+     * 
+     * @param path Resource path
+     * @param payload Message payload
+     * @param type CONFIRMABLE or NON_CONFIRMABLE
+     * @param exchangeId Optional pointer to store the exchange ID
+     * @param method Request method
+     * @param format Content format
+     * @return true if the first datagram was sent, false otherwise
+     */
+    bool sendAsync(
+        const std::string& path,
+        const std::string& payload,
+        CoAPMessageType type,
+        uint32_t* exchangeId = nullptr,
+        CoAPMethod method = CoAPMethod::POST,
+        CoAPContentFormat format = CoAPContentFormat::JSON
+    );
+    
+    /**
+     * @brief Set the callback for completed asynchronous exchanges
+     * 
+     * @param callback Function to call with the exchange ID and outcome
+     */
+    void setCompletionCallback(CoAPCompletionCallback callback);
+    
+    /**
+     * @brief Register an observation on a resource
+     * 
+     * @param path Resource path (e.g. "commands")
+     * @param callback Function to call for each notification
+     * @return true if the observation was accepted, false otherwise
+     */
+    bool observe(const std::string& path, CoAPObserveCallback callback);
+    
+    /**
+     * @brief Cancel an observation
+     * 
+     * @param path Resource path
+     * @return true if successful, false otherwise
+     */
+    bool cancelObserve(const std::string& path);
+    
+    /**
+     * @brief Set the block size used for block-wise transfer
+     * 
+     * @param size Block size
+     */
+    void setBlockSize(CoAPBlockSize size);
+    
+    /**
+     * @brief Get current client state
+     * 
+     * @return Current client state
+     */
+    CoAPClientState getState() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    /**
+     * @brief Outstanding confirmable exchange
+     */
+    struct PendingExchange {
+        std::vector<uint8_t> datagram;  ///< Encoded message for retransmission
+        uint64_t nextRetransmitMs;      ///< Time of the next retransmission
+        uint32_t timeoutMs;             ///< Current backoff timeout
+        uint8_t retransmissions;        ///< Retransmissions performed so far
+        bool acknowledged;              ///< Set when the matching ACK arrives
+        uint32_t exchangeId;            ///< sendAsync() exchange, 0 for blocking sends
+    };
+    
+    /**
+     * @brief Outstanding asynchronous exchange
+     */
+    struct AsyncExchange {
+        std::string path;               ///< Resource path
+        std::string payload;            ///< Full payload, kept for the remaining blocks
+        CoAPMessageType type;           ///< CON or NON
+        CoAPMethod method;              ///< Request method
+        CoAPContentFormat format;       ///< Content format
+        uint32_t nextBlock;             ///< Next Block1 number to send
+    };
+    
+    /**
+     * @brief Active observation
+     */
+    struct Observation {
+        std::vector<uint8_t> token;     ///< Token identifying the observation
+        CoAPObserveCallback callback;   ///< Notification callback
+        uint32_t lastSequence;          ///< Last observe sequence number seen
+    };
+    
+    std::string mServer;
+    uint16_t mPort;
+    bool mUseDtls;
+    DTLSCredentials mCredentials;
+    int mSocket;
+    CoAPClientState mState;
+    CoAPBlockSize mBlockSize;
+    uint16_t mNextMessageId;
+    uint64_t mNextToken;
+    std::map<uint16_t, PendingExchange> mPending;    ///< Pending CON exchanges by message ID
+    std::map<std::string, Observation> mObservations; ///< Observations by resource path
+    std::map<uint32_t, AsyncExchange> mAsyncExchanges; ///< sendAsync() exchanges by exchange ID
+    uint32_t mNextExchangeId;
+    CoAPCompletionCallback mCompletionCallback;
+    std::vector<uint8_t> mRxBuffer;
+    System::ErrorCode mLastError;
+    std::mutex mMutex;
+    
+    /**
+     * @brief Encode a message into a datagram
+     * 
+     * @param type Message type
+     * @param code Method or response code
+     * @param messageId Message ID
+     * @param token Token bytes
+     * @param path Resource path (split into Uri-Path options)
+     * @param options Additional encoded options, sorted by number
+     * @param payload Payload bytes
+     * @param length Payload length
+     * @param out Buffer to store the datagram
+     */
+    void encodeMessage(CoAPMessageType type, uint8_t code, uint16_t messageId,
+                       const std::vector<uint8_t>& token, const std::string& path,
+                       const std::vector<std::pair<uint16_t, std::vector<uint8_t>>>& options,
+                       const uint8_t* payload, size_t length, std::vector<uint8_t>& out);
+    
+    /**
+     * @brief Send a payload with Block1 transfer
+     * 
+     * @param path Resource path
+     * @param payload Message payload
+     * @param method Request method
+     * @param format Content format
+     * @return true if all blocks were acknowledged, false otherwise
+     */
+    bool sendBlockwise(const std::string& path, const std::string& payload,
+                       CoAPMethod method, CoAPContentFormat format);
+    
+    /**
+     * @brief Handle a received datagram
+     * 
+     * @param data Datagram bytes
+     * @param length Datagram length
+     */
+    void onDatagramReceived(const uint8_t* data, size_t length);
+    
+    /**
+     * @brief Send the next block of an asynchronous exchange, or complete it
+     * 
+     * Called after the previous block was acknowledged (CON) or sent (NON).
+     * 
+     * @param exchangeId Exchange ID
+     */
+    void advanceAsyncExchange(uint32_t exchangeId);
+    
+    /**
+     * @brief Retransmit expired confirmable exchanges
+     * 
+     * @param nowMs Current time in milliseconds
+     */
+    void processRetransmissions(uint64_t nowMs);
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Communication
+
+#endif // COAP_CLIENT_H
@@ -15,11 +15,31 @@
 #include <memory>
 #include <cstdint>
 #include <functional>
+#include <deque>
+#include <array>
+#include <string_view>
+#include <mutex>
 #include "../config.h"
 #include "../sensors/sensor_base.h"
 #include "../system/error_handler.h"
+#include "../storage/timeseries_query.h"
+#include "../storage/write_ahead_journal.h"
+#include "../system/runtime_config.h"
+#include "../system/latency_tracer.h"
+#include "../system/logger.h"
+#include "../system/metrics_registry.h"
+#include "../data/rules_engine.h"
 #include "mqtt_client.h"
+#include "mqtt_connection_pool.h"
 #include "coap_client.h"
+#include "tls_context.h"
+#include "payload_cipher.h"
+#include "command_dispatcher.h"
+#include "delta_encoder.h"
+#include "bandwidth_shaper.h"
+#include "buffer_chain.h"
+#include "error_aggregator.h"
+#include "status_registry.h"
 
 namespace Communication {
 
@@ -32,6 +52,8 @@ enum class TransmissionStatus {
     AUTHENTICATION_ERROR,
     TIMEOUT,
     DATA_ERROR,
+    DEFERRED,       ///< Queued in the outbox until the bandwidth budget allows
+    COALESCED,      ///< Merged into an aggregated report, nothing sent yet
     UNKNOWN_ERROR
 };
 
@@ -45,6 +67,48 @@ enum class MessagePriority {
     CRITICAL
 };
 
+/**
+ * @brief Bookkeeping that follows a message until its delivery completes
+ * 
+ * Registered against the delivery ID when the message is actually
+ * handed to the transport, so deferred messages keep it while they wait
+ * in the outbox.
+ */
+struct DeliveryContext {
+    static constexpr size_t MAX_TRACES = DeviceConfig::TRACE_MAX_PER_MESSAGE;
+    
+    uint32_t deltaSequence;                    ///< Delta frame sequence, 0 if not a delta frame
+    std::vector<uint64_t> journalLsns;         ///< Journal LSNs of the readings in the message
+    uint32_t statusSequence;                   ///< Status update sequence, 0 if not a status update
+    std::array<uint32_t, MAX_TRACES> traceIds; ///< Traced readings in the message
+    uint8_t traceCount;                        ///< Valid entries in traceIds
+    
+    DeliveryContext()
+        : deltaSequence(0), journalLsns(), statusSequence(0), traceIds(), traceCount(0) {}
+};
+
+/**
+ * @brief Message waiting in the outbox for bandwidth budget
+ */
+struct PendingMessage {
+    std::string topic;
+    BufferChain payload;
+    MessagePriority priority;
+    uint64_t enqueuedAt;
+    DeliveryContext context;   ///< Registered when the message is published
+
+    PendingMessage()
+        : topic(), payload(), priority(MessagePriority::NORMAL), enqueuedAt(0), context() {}
+};
+
+/**
+ * @brief Telemetry payload encodings
+ */
+enum class TelemetryEncoding {
+    JSON,   ///< Full readings as JSON on MQTT_TOPIC_TELEMETRY
+    DELTA   ///< Changed channels only on MQTT_TOPIC_TELEMETRY_DELTA, see DeltaEncoder
+};
+
 /**
  * @brief Data message structure
  */
@@ -60,7 +124,7 @@ struct DataMessage {
           timestamp(0), 
           readings(), 
           priority(MessagePriority::NORMAL),
-          encrypted(DeviceConfig::ENABLE_TLS) {}
+          encrypted(DeviceConfig::ENABLE_PAYLOAD_ENCRYPTION) {}
 };
 
 /**
@@ -70,6 +134,14 @@ using CommandCallback = std::function<void(const std::string&, const std::string
 
 /**
  * @brief Communication manager class
+ * 
+ * Public methods may be called from any thread. The outbox, the
+ * in-flight deliveries, the delta encoder, the journal bookkeeping and
+ * the copy statistics are shared by callers of the send methods, the
+ * command worker and the transport callback threads, and are guarded by
+ * mStateMutex. The mutex is never held while calling into the
+ * transports or user callbacks, so acknowledgements arriving during a
+ * publish cannot deadlock.
  */
 class CommManager {
 public:
@@ -86,13 +158,35 @@ public:
     /**
      * @brief Initialize the communication manager
      * 
+     * Allows MQTT_TOPIC_CONFIG and MQTT_TOPIC_RULES messages up to
+     * COMMAND_MAX_LARGE_MESSAGE_SIZE before starting the command
+     * dispatcher. With USE_COAP, the CoAP client connects to COAP_PORT
+     * over DTLS, using the PSK from COAP_PSK_KEY_PATH if that file exists
+     * and the shared TLS context otherwise.
+     * 
      * @return true if initialization successful, false otherwise
      */
     bool initialize();
     
+    /**
+     * @brief Add an MQTT broker
+     * 
+     * Must be called before initialize(). Without explicit brokers,
+     * initialize() adds MQTT_BROKER as PRIMARY and, if configured,
+     * MQTT_REGIONAL_BROKER as MIRROR.
+     * 
+     * @param endpoint Broker endpoint
+     * @return true if added, false otherwise
+     */
+    bool addBroker(const BrokerEndpoint& endpoint);
+    
     /**
      * @brief Connect to the backend platform
      * 
+     * Subscribes to MQTT_TOPIC_COMMANDS_FILTER, which covers
+     * MQTT_TOPIC_COMMANDS and its sub-topics MQTT_TOPIC_HISTORY_REQUEST,
+     * MQTT_TOPIC_CONFIG and MQTT_TOPIC_RULES.
+     * 
      * @return true if connection successful, false otherwise
      */
     bool connect();
@@ -107,6 +201,18 @@ public:
     /**
      * @brief Send sensor readings to the platform
      * 
+     * Uses MQTT when USE_MQTT is set and the pool is connected, and CoAP
+     * when USE_COAP is set and MQTT is disabled or down. Over MQTT the
+     * payload goes to the active primary broker and every MIRROR
+     * broker. Over CoAP the payload is posted to COAP_URI_TELEMETRY;
+     * CRITICAL and HIGH priority messages are sent confirmable and the
+     * rest non-confirmable, batches larger than COAP_BLOCK_SIZE use
+     * block-wise transfer, and the call never waits for retransmissions.
+     * 
+     * @param readings Vector of sensor readings
+     * The journalLsn of each reading, set at acquisition, goes into the
+     * delivery context.
+     * 
      * @param readings Vector of sensor readings
      * @param priority Message priority
      * @return Transmission status
@@ -115,6 +221,57 @@ public:
         const std::vector<Sensors::SensorReading>& readings,
         MessagePriority priority = MessagePriority::NORMAL);
     
+    /**
+     * @brief Set the global uplink budget
+     * 
+     * @param budget Byte and message budget
+     * @param controlReservePercent Share kept for HIGH and CRITICAL traffic
+     */
+    void setBandwidthBudget(const BandwidthBudget& budget,
+                            uint8_t controlReservePercent = DeviceConfig::UPLINK_CONTROL_RESERVE_PERCENT);
+    
+    /**
+     * @brief Set the uplink budget of a single topic
+     * 
+     * @param topic Topic
+     * @param budget Byte and message budget
+     */
+    void setTopicBandwidthBudget(const std::string& topic, const BandwidthBudget& budget);
+    
+    /**
+     * @brief Send deferred messages as the bandwidth budget allows
+     * 
+     * Drains the outbox highest priority first, then resends the
+     * readings of failed deliveries (see attachJournal()) once the
+     * outbox is empty; call periodically from the communication loop.
+     * 
+     * @return Number of messages sent
+     */
+    size_t processOutbox();
+    
+    /**
+     * @brief Get payload copy counters
+     * 
+     * @return Copies and bytes copied per published payload
+     */
+    PayloadCopyStats getCopyStats() const;
+    
+    /**
+     * @brief Get bandwidth shaper counters
+     * 
+     * @return Shaper counters including deferred bytes
+     */
+    ShaperStats getShaperStats() const;
+    
+    /**
+     * @brief Select the telemetry payload encoding
+     * 
+     * Switching to DELTA forces a keyframe on the next send.
+     * 
+     * @param encoding Telemetry encoding
+     */
+    void setTelemetryEncoding(TelemetryEncoding encoding);
+    
     /**
      * @brief Send device status information
      * 
@@ -123,22 +280,174 @@ public:
      */
     TransmissionStatus sendStatusUpdate(const std::string& status);
     
+    /**
+     * @brief Send the fields of the status registry that changed
+     * 
+     * Refreshes the manager's own fields (queue depths, link and shaper
+     * statistics), then serializes the dirty fields straight into a
+     * segment from the control pool. A full snapshot larger than one
+     * segment is sent as several messages of one segment each, up to
+     * STATUS_MAX_IN_FLIGHT per call; while
+     * DeviceStatusRegistry::snapshotPending() holds, the remaining parts
+     * follow on the next calls ahead of any delta. Call every
+     * STATUS_INTERVAL_MS. The
+     * fields stay pending until the update is acknowledged; if it is
+     * dropped they are sent again with the next update.
+     * 
+     * @return Transmission status, SUCCESS without sending if nothing changed
+     */
+    TransmissionStatus sendStatusUpdate();
+    
+    /**
+     * @brief Get the device status registry
+     * 
+     * Other components register their fields here at startup.
+     * 
+     * @return Status registry
+     */
+    DeviceStatusRegistry& getStatusRegistry();
+    
     /**
      * @brief Send error report
      * 
+     * Reports go through the error aggregator: the first occurrence of
+     * an (errorCode, sensorId) pair is queued at HIGH priority right away,
+     * repeats within ERROR_AGGREGATION_WINDOW_MS are only counted and
+     * sent as one summary by flushErrorReports().
+     * 
      * @param errorCode Error code
      * @param message Error message
-     * @return Transmission status
+     * @param sensorId Originating sensor, or ErrorAggregator::NO_SENSOR
+     * @return Transmission status, COALESCED if the report was only counted
+     */
+    TransmissionStatus sendErrorReport(System::ErrorCode errorCode, const std::string& message,
+                                       Sensors::SensorId sensorId = ErrorAggregator::NO_SENSOR);
+    
+    /**
+     * @brief Queue summaries for error windows that have closed
+     * 
+     * Call periodically from the communication loop.
+     * 
+     * @return Number of summaries queued
      */
-    TransmissionStatus sendErrorReport(System::ErrorCode errorCode, const std::string& message);
+    size_t flushErrorReports();
     
     /**
      * @brief Register callback for incoming commands
      * 
+     * The callback runs on the command worker thread and receives
+     * every command that no handler registered with
+     * registerCommandHandler() matches.
+     * 
      * @param callback Function to call when command is received
      */
     void registerCommandCallback(CommandCallback callback);
     
+    /**
+     * @brief Register a handler for commands matching a topic filter
+     * 
+     * @param filter Topic filter (MQTT wildcard syntax)
+     * @param handler Handler to call on the command worker thread
+     * @return true if registered, false otherwise
+     */
+    bool registerCommandHandler(const std::string& filter, CommandHandler handler);
+    
+    /**
+     * @brief Serve history requests from the local time-series store
+     * 
+     * Registers a handler for MQTT_TOPIC_HISTORY_REQUEST. Results are
+     * paged into messages of HISTORY_POINTS_PER_MESSAGE points and
+     * published on MQTT_TOPIC_HISTORY at NORMAL priority: the shaper still
+     * paces them against live traffic, but a full outbox drops LOW
+     * telemetry before a requested reply.
+     * 
+     * @param store Local time-series store
+     * @return true if successful, false otherwise
+     */
+    bool attachTimeSeriesStore(std::shared_ptr<Storage::TimeSeriesStore> store);
+    
+    /**
+     * @brief Complete sent readings in the write-ahead journal
+     * 
+     * Each message completes the LSNs of its readings with
+     * WriteAheadJournal::complete() when the broker acknowledges it or
+     * right after a CoAP NON or MQTT QoS 0 send. The journal tracks
+     * completions per LSN, so out-of-order acks across pool connections
+     * need no bookkeeping here. The LSNs of failed or dropped deliveries
+     * are not completed; they are queued in mReplayLsns and resent by
+     * processOutbox() through WriteAheadJournal::replay().
+     * 
+     * @param journal Journal the acquisition loop appends to
+     */
+    void attachJournal(std::shared_ptr<Storage::WriteAheadJournal> journal);
+    
+    /**
+     * @brief Accept configuration updates over MQTT_TOPIC_CONFIG
+     * 
+     * Registers a command handler that applies updates to the manager
+     * and acknowledges them on the status topic, and subscribes the
+     * bandwidth shaper, the status interval and the attached journal's
+     * sync interval (journalSyncIntervalMs) to configuration changes.
+     * 
+     * @param config Configuration manager
+     */
+    void attachConfigManager(std::shared_ptr<System::ConfigManager> config);
+    
+    /**
+     * @brief Trace sampled readings through serialization, publish and ack
+     * 
+     * Stamps SERIALIZED for traced readings in each batch, PUBLISHED when
+     * the pool reports the socket write, and ACKNOWLEDGED when the broker
+     * confirms delivery, and exports the per-stage histograms through
+     * the status registry. Trace IDs travel in the fixed-size
+     * DeliveryContext, so tracing adds no allocation per message.
+     * 
+     * @param tracer Latency tracer
+     */
+    void attachTracer(std::shared_ptr<System::LatencyTracer> tracer);
+    
+    /**
+     * @brief Serialize readings the way sendSensorData() would
+     * 
+     * Formats the JSON payload without encrypting, queuing or sending
+     * it, for tools that measure or record the wire format.
+     * 
+     * @param readings Sensor readings
+     * @param chain Chain to append the JSON to
+     * @return true if successful, false if the buffer pool is exhausted
+     */
+    bool serializeSensorData(const std::vector<Sensors::SensorReading>& readings, BufferChain& chain);
+    
+    /**
+     * @brief Publish rule firings and accept rule updates
+     * 
+     * Firings are sent on MQTT_TOPIC_ALERTS with the rule's priority, so
+     * the bandwidth shaper always admits CRITICAL alerts and lets HIGH
+     * ones use the control reserve. Rule sets of up to
+     * COMMAND_MAX_LARGE_MESSAGE_SIZE received on MQTT_TOPIC_RULES are
+     * compiled, installed and saved to RULES_PATH; compile errors are
+     * reported on the status topic.
+     * 
+     * @param rules Rules engine
+     */
+    void attachRulesEngine(std::shared_ptr<Data::RulesEngine> rules);
+    
+    /**
+     * @brief Get command dispatch statistics
+     * 
+     * @return Dispatch statistics including receive-to-handler latency
+     */
+    DispatchStats getCommandStats() const;
+    
+    /**
+     * @brief Rotate the end-to-end payload encryption key
+     * 
+     * @param keyId Identifier of the new key
+     * @param key Key material, 32 bytes (16 only with AES-128-GCM pinned)
+     * @return false if the key length does not suit the cipher, true if installed
+     */
+    bool rotatePayloadKey(uint32_t keyId, const std::vector<uint8_t>& key);
+    
     /**
      * @brief Check connection status
      * 
@@ -154,37 +463,218 @@ public:
     System::ErrorCode getLastError() const;
 
 private:
+    /**
+     * @brief Uplink transports
+     */
+    enum class Transport {
+        NONE,
+        MQTT,
+        COAP
+    };
+    
+    /**
+     * @brief Delivery awaiting completion
+     */
+    struct InFlightDelivery {
+        uint32_t deliveryId;       ///< Pool delivery ID or CoAP exchange ID, per table
+        bool active;               ///< Whether the slot is in use
+        bool written;              ///< Socket write reported before the context was registered
+        DeliveryContext context;   ///< Context of the published message
+        
+        InFlightDelivery() : deliveryId(0), active(false), written(false), context() {}
+    };
+    
     bool mInitialized;
     bool mConnected;
     System::ErrorCode mLastError;
     CommandCallback mCommandCallback;
     
-    std::unique_ptr<MQTTClient> mMqttClient;
+    std::unique_ptr<MQTTConnectionPool> mMqttPool;
     std::unique_ptr<CoAPClient> mCoapClient;
+    std::shared_ptr<TLSContext> mTlsContext;
+    PayloadCipher mPayloadCipher;
+    BufferPool mBufferPool;               ///< Telemetry, history and error report payloads
+    BufferPool mControlPool;              ///< CRITICAL and status payloads, never starved by telemetry
+    PayloadCopyStats mCopyStats;
+    ErrorAggregator mErrorAggregator;
+    DeviceStatusRegistry mStatusRegistry;
+    std::shared_ptr<Storage::TimeSeriesStore> mTimeSeriesStore;
+    std::unique_ptr<Storage::TimeSeriesQuery> mTimeSeriesQuery;
+    std::shared_ptr<Storage::WriteAheadJournal> mJournal;
+    std::vector<uint64_t> mReplayLsns;    ///< Journal LSNs of failed deliveries, resent by processOutbox()
+    std::shared_ptr<System::ConfigManager> mConfigManager;
+    std::shared_ptr<System::LatencyTracer> mTracer;
+    std::shared_ptr<Data::RulesEngine> mRulesEngine;
+    std::array<InFlightDelivery, DeviceConfig::DELIVERY_MAX_IN_FLIGHT>
+        mMqttInFlight;                             ///< Pool deliveries, slot = delivery ID % size
+    std::array<InFlightDelivery, DeviceConfig::DELIVERY_MAX_IN_FLIGHT>
+        mCoapInFlight;                             ///< CoAP exchanges, slot = exchange ID % size
+    CommandDispatcher mCommandDispatcher;
+    TelemetryEncoding mTelemetryEncoding;
+    DeltaEncoder mDeltaEncoder;
+    std::vector<uint8_t> mDeltaBuffer;             ///< Reusable delta frame buffer
+    BandwidthShaper mShaper;
+    std::array<std::deque<PendingMessage>, 4> mOutbox; ///< Deferred messages indexed by priority
+    size_t mOutboxBytes;
+    std::array<System::Gauge, 4> mOutboxDepthMetric; ///< outbox_messages{priority="..."}
+    System::Gauge mOutboxBytesMetric;     ///< outbox_bytes
+    System::Counter mOutboxDroppedMetric; ///< outbox_dropped_total
+    mutable std::mutex mStateMutex;       ///< Guards the outbox, deliveries, delta and journal state
     
     /**
      * @brief Internal command handler
      * 
+     * Runs on the network thread and only queues the command on
+     * mCommandDispatcher, so slow handlers never stall acks.
+     * 
      * @param topic Command topic
      * @param payload Command payload
      */
-    void handleCommand(const std::string& topic, const std::string& payload);
+    void handleCommand(std::string_view topic, std::string_view payload);
+    
+    /**
+     * @brief Handle a history request on the command worker thread
+     * 
+     * @param topic Command topic
+     * @param payload Request, see Storage::TimeSeriesQuery::parseRequest()
+     */
+    void handleHistoryCommand(std::string_view topic, std::string_view payload);
     
     /**
      * @brief Convert sensor data to JSON format
      * 
+     * The JSON is formatted directly into pooled segments, with
+     * PayloadCipher::HEADER_SIZE bytes of headroom in the first segment
+     * so it can be sealed in place. Callers sending at CRITICAL priority
+     * pass a chain drawn from mControlPool, so a full outbox cannot block them.
+     * 
      * @param readings Sensor readings
-     * @return JSON string
+     * @param chain Chain to append the JSON to
+     * @return true if successful, false if the buffer pool is exhausted
+     */
+    bool sensorDataToJson(const std::vector<Sensors::SensorReading>& readings, BufferChain& chain);
+    
+    /**
+     * @brief Publish a payload on the configured transport
+     * 
+     * Messages the bandwidth shaper does not admit are queued in the
+     * outbox and DEFERRED is returned. When the outbox exceeds
+     * OUTBOX_MAX_BYTES the oldest LOW priority messages are dropped first;
+     * a dropped message completes its context as a failed delivery.
+     * Failed publishes are logged with LOG_EVERY_N at WARNING and outbox
+     * drops at INFO, each with the topic and priority.
+     * 
+     * @param topic MQTT topic, mapped to a COAP_URI_* path by coapPathFor()
+     * @param payload Payload chain, moved into the connection queue or outbox
+     * @param priority Message priority, mapped to QoS or CON/NON
+     * @param context Delivery context, kept with the message in the outbox
+     * @return Transmission status
+     */
+    TransmissionStatus transmit(const std::string& topic, BufferChain&& payload,
+                                MessagePriority priority,
+                                const DeliveryContext& context = DeliveryContext());
+    
+    /**
+     * @brief Record the context of a message handed to the transport
+     * 
+     * Called by transmit() and processOutbox() once a delivery ID exists.
+     * Pool delivery IDs and CoAP exchange IDs come from separate counters,
+     * so each transport has its own table. A slot still holding an older
+     * unfinished delivery of the same transport is completed as failed
+     * first.
+     * 
+     * @param transport Transport the message was handed to, MQTT or COAP
+     * @param deliveryId Pool delivery ID or CoAP exchange ID
+     * @param context Delivery context
+     */
+    void registerDelivery(Transport transport, uint32_t deliveryId, const DeliveryContext& context);
+    
+    /**
+     * @brief Get the in-flight slot of a delivery
+     * 
+     * @param transport MQTT or COAP
+     * @param deliveryId Pool delivery ID or CoAP exchange ID
+     * @return Slot in mMqttInFlight or mCoapInFlight
+     */
+    InFlightDelivery& inFlightSlot(Transport transport, uint32_t deliveryId);
+    
+    /**
+     * @brief Pick the transport for the next message
+     * 
+     * @return MQTT or COAP per USE_MQTT/USE_COAP and link state, NONE if neither is usable
+     */
+    Transport selectTransport() const;
+    
+    /**
+     * @brief Map an MQTT topic to its CoAP resource path
+     * 
+     * @param topic MQTT topic
+     * @return COAP_URI_TELEMETRY, COAP_URI_STATUS or COAP_URI_COMMANDS for
+     *         the matching topics, the topic itself otherwise
+     */
+    static const char* coapPathFor(const std::string& topic);
+    
+    /**
+     * @brief Handle a finished asynchronous CoAP exchange
+     * 
+     * Runs on the CoAP receive thread and completes the delivery in
+     * mCoapInFlight like an MQTT acknowledgement; failed CON exchanges
+     * count as failed deliveries.
+     * 
+     * @param exchangeId Exchange ID returned by CoAPClient::sendAsync()
+     * @param success Whether the exchange succeeded
+     */
+    void onCoapExchangeComplete(uint32_t exchangeId, bool success);
+    
+    /**
+     * @brief Encrypt data in place using the payload cipher
+     * 
+     * Each segment is sealed in place with the streaming API, the header
+     * goes into the first segment's headroom and the tag is appended.
+     * 
+     * @param chain Chain produced by sensorDataToJson()
+     * @param topic Topic the payload is published on, authenticated as AAD
+     * @return true if successful, false otherwise
+     */
+    bool encryptData(BufferChain& chain, const std::string& topic);
+    
+    /**
+     * @brief Handle a completed delivery from the MQTT pool
+     * 
+     * Looks up the delivery's context in mMqttInFlight. Delivered
+     * messages promote their delta frame, complete their traces,
+     * confirm their status update and complete their journal LSNs;
+     * failed ones re-dirty the status fields and queue their journal
+     * LSNs in mReplayLsns. Both release the slot.
+     * 
+     * @param deliveryId Delivery ID of the publish
+     * @param delivered Whether the broker acknowledged the message
      */
-    std::string sensorDataToJson(const std::vector<Sensors::SensorReading>& readings);
+    void onPublishAcknowledged(uint32_t deliveryId, bool delivered);
     
     /**
-     * @brief Encrypt data using configured method
+     * @brief Handle a message written to the socket by the MQTT pool
+     * 
+     * Stamps PUBLISHED for the traced readings of the delivery. A write
+     * reported before registerDelivery() ran only sets the slot's
+     * written flag, and registerDelivery() stamps PUBLISHED instead.
      * 
-     * @param data Data to encrypt
-     * @return Encrypted data
+     * @param deliveryId Delivery ID of the publish
      */
-    std::string encryptData(const std::string& data);
+    void onPublishWritten(uint32_t deliveryId);
+    
+    /**
+     * @brief Serialize an error summary and queue it for transmission
+     * 
+     * @param summary Aggregated error
+     * @param firstOccurrence Whether this is the first occurrence of the key
+     */
+    void queueErrorSummary(const ErrorSummary& summary, bool firstOccurrence);
+    
+    /**
+     * @brief Register and refresh the manager's own status fields
+     */
+    void updateOwnStatusFields();
     
     /**
      * @brief Set the last error code
@@ -196,6 +686,12 @@ private:
     /**
      * @brief Initialize TLS/SSL configuration
      * 
+     * Loads the TLS_*_PATH certificates into a shared TLSContext once
+     * and hands the context to the protocol clients. Only with
+     * TLS_PERSIST_SESSIONS are session tickets restored from
+     * TLS_SESSION_CACHE_PATH, sealed under the key in
+     * TLS_SESSION_KEY_PATH; without that key nothing is persisted.
+     * 
      * @return true if successful, false otherwise
      */
     bool initializeTLS();
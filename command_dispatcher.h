@@ -0,0 +1,276 @@
+/**
+ * @file command_dispatcher.h
+ * @brief Asynchronous dispatch of inbound commands
+ * 
+ * This file provides a dispatcher that takes inbound messages off the
+ * network thread through a bounded lock-free queue and routes them to
+ * handlers on a worker thread using an MQTT-style topic trie.
+ */
+
+#ifndef COMMAND_DISPATCHER_H
+#define COMMAND_DISPATCHER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../system/bounded_queue.h"
+#include "../system/metrics_registry.h"
+
+namespace Communication {
+
+/**
+ * @brief Command handler function type
+ * 
+ * The views point into the dispatcher's slot buffer and are only
+ * valid for the duration of the call.
+ */
+using CommandHandler = std::function<void(std::string_view, std::string_view)>;
+
+/**
+ * @brief Dispatch latency and throughput statistics
+ */
+struct DispatchStats {
+    static constexpr size_t LATENCY_BUCKETS = 32;
+    
+    uint64_t received;        ///< Messages accepted from the network thread
+    uint64_t dispatched;      ///< Messages delivered to at least one handler
+    uint64_t unrouted;        ///< Messages that matched no handler
+    uint64_t dropped;         ///< Messages dropped because the queue was full or too large
+    uint64_t totalLatencyNs;  ///< Sum of receive-to-handler latencies
+    uint64_t maxLatencyNs;    ///< Maximum receive-to-handler latency
+    std::array<uint64_t, LATENCY_BUCKETS> latencyHistogram; ///< Bucket i counts latencies in [2^i, 2^(i+1)) ns
+    
+    DispatchStats()
+        : received(0), dispatched(0), unrouted(0), dropped(0),
+          totalLatencyNs(0), maxLatencyNs(0), latencyHistogram() {}
+};
+
+/**
+ * @brief Topic trie for routing messages to handlers
+ * 
+ * Filters follow MQTT syntax: '+' matches one level and a trailing
+ * '#' matches any number of remaining levels.
+ */
+class TopicTrie {
+public:
+    /**
+     * @brief Constructor
+     */
+    TopicTrie();
+    
+    /**
+     * @brief Destructor
+     */
+    ~TopicTrie();
+    
+    /**
+     * @brief Add a handler for a topic filter
+     * 
+     * @param filter Topic filter
+     * @param handler Handler to call for matching topics
+     * @return true if added, false if the filter is malformed
+     */
+    bool insert(const std::string& filter, CommandHandler handler);
+    
+    /**
+     * @brief Remove all handlers for a topic filter
+     * 
+     * @param filter Topic filter
+     * @return true if removed, false if not found
+     */
+    bool remove(const std::string& filter);
+    
+    /**
+     * @brief Call every handler whose filter matches the topic
+     * 
+     * Walks the trie level by level without allocating.
+     * 
+     * @param topic Topic of the message
+     * @param payload Message payload
+     * @return Number of handlers called
+     */
+    size_t dispatch(std::string_view topic, std::string_view payload) const;
+
+private:
+    struct Node {
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+        std::unique_ptr<Node> singleLevel;   ///< '+' child
+        std::vector<CommandHandler> multiLevel; ///< Handlers registered with a trailing '#'
+        std::vector<CommandHandler> handlers; ///< Handlers terminating at this node
+    };
+    
+    std::unique_ptr<Node> mRoot;
+    
+    /**
+     * @brief Recursively match remaining topic levels
+     * 
+     * @param node Current node
+     * @param topic Remaining topic levels
+     * @param fullTopic Full topic passed to handlers
+     * @param payload Message payload
+     * @return Number of handlers called
+     */
+    size_t match(const Node* node, std::string_view topic, std::string_view fullTopic,
+                 std::string_view payload) const;
+};
+
+/**
+ * @brief Command dispatcher class
+ * 
+ * Messages are copied once from the receive buffer into a preallocated
+ * slot, the slot index travels through a lock-free queue, and handlers
+ * see string_views into the slot. Slots are recycled through a second
+ * lock-free queue, so the network thread never blocks or allocates.
+ * Topics allowed with allowLargeMessages() may exceed maxMessageSize and
+ * use a few larger slots from a separate free queue.
+ */
+class CommandDispatcher {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param queueDepth Number of in-flight messages
+     * @param maxMessageSize Maximum topic plus payload size in bytes
+     * @param largeSlotCount Number of slots for large messages
+     * @param maxLargeMessageSize Maximum size of a message in a large slot
+     */
+    CommandDispatcher(
+        size_t queueDepth = DeviceConfig::COMMAND_QUEUE_DEPTH,
+        size_t maxMessageSize = DeviceConfig::COMMAND_MAX_MESSAGE_SIZE,
+        size_t largeSlotCount = DeviceConfig::COMMAND_LARGE_SLOT_COUNT,
+        size_t maxLargeMessageSize = DeviceConfig::COMMAND_MAX_LARGE_MESSAGE_SIZE
+    );
+    
+    /**
+     * @brief Destructor, stops the worker thread
+     */
+    ~CommandDispatcher();
+    
+    /**
+     * @brief Start the worker thread
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool start();
+    
+    /**
+     * @brief Stop the worker thread after draining queued messages
+     */
+    void stop();
+    
+    /**
+     * @brief Register a handler for a topic filter
+     * 
+     * May be called at any time; the router is guarded by a
+     * reader/writer lock that the worker holds shared while dispatching,
+     * so a new handler takes effect from the next message.
+     * 
+     * @param filter Topic filter (MQTT wildcard syntax)
+     * @param handler Handler to call on the worker thread
+     * @return true if registered, false otherwise
+     */
+    bool registerHandler(const std::string& filter, CommandHandler handler);
+    
+    /**
+     * @brief Set the handler for messages no filter matches
+     * 
+     * @param handler Handler to call on the worker thread, may be empty
+     */
+    void setFallbackHandler(CommandHandler handler);
+    
+    /**
+     * @brief Let messages on a topic use the large slots
+     * 
+     * Must be called before start(); post() reads the list without
+     * locking.
+     * 
+     * @param topic Exact topic, e.g. MQTT_TOPIC_RULES
+     * @return true if added, false if the dispatcher is already running
+     */
+    bool allowLargeMessages(const std::string& topic);
+    
+    /**
+     * @brief Queue a message for dispatch
+     * 
+     * Called on the network thread; copies the message into a free slot
+     * and returns immediately. Messages larger than maxMessageSize take a
+     * large slot if their topic was allowed, and are dropped otherwise.
+     * 
+     * @param topic Message topic
+     * @param payload Message payload
+     * @return true if queued, false if dropped
+     */
+    bool post(std::string_view topic, std::string_view payload);
+    
+    /**
+     * @brief Get dispatch statistics
+     * 
+     * @return Snapshot of the statistics
+     */
+    DispatchStats getStats() const;
+    
+    /**
+     * @brief Get the number of queued messages
+     * 
+     * @return Queue depth
+     */
+    size_t getQueueDepth() const;
+
+private:
+    struct Slot {
+        uint64_t receivedNs;   ///< Receive timestamp (steady clock)
+        uint32_t topicLength;  ///< Topic length
+        uint32_t payloadLength; ///< Payload length
+    };
+    
+    size_t mMaxMessageSize;
+    size_t mMaxLargeMessageSize;
+    std::vector<Slot> mSlots;            ///< Regular slots, then large slots
+    std::unique_ptr<char[]> mSlotData;   ///< Slot storage, maxMessageSize bytes per slot
+    std::unique_ptr<char[]> mLargeSlotData; ///< Large slot storage, maxLargeMessageSize bytes per slot
+    std::vector<std::string> mLargeTopics; ///< Topics allowed in large slots, fixed once started
+    System::BoundedQueue<uint32_t> mReady; ///< Slots waiting for dispatch
+    System::BoundedQueue<uint32_t> mFree;  ///< Slots available to the network thread
+    System::BoundedQueue<uint32_t> mLargeFree; ///< Large slots available to the network thread
+    TopicTrie mRouter;
+    CommandHandler mFallback;            ///< Called when no filter in mRouter matches
+    mutable std::shared_mutex mRouterMutex; ///< Guards mRouter and mFallback
+    std::thread mWorker;
+    std::atomic<bool> mRunning;
+    std::mutex mWakeMutex;
+    std::condition_variable mWakeCondition;
+    std::atomic<uint64_t> mReceived;
+    std::atomic<uint64_t> mDropped;
+    DispatchStats mStats;                ///< Worker-owned statistics
+    System::Gauge mQueueDepthMetric;     ///< command_queue_depth, sampled by the worker
+    System::Histogram mLatencyMetric;    ///< command_dispatch_latency_us
+    mutable std::mutex mStatsMutex;
+    
+    /**
+     * @brief Worker thread loop
+     */
+    void workerLoop();
+    
+    /**
+     * @brief Record the latency of a dispatched message
+     * 
+     * @param latencyNs Receive-to-handler latency
+     * @param handlers Number of handlers called
+     */
+    void recordDispatch(uint64_t latencyNs, size_t handlers);
+};
+
+} // namespace Communication
+
+#endif // COMMAND_DISPATCHER_H
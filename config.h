@@ -33,6 +33,14 @@ namespace DeviceConfig {
     constexpr char TLS_CA_CERT_PATH[] = "/certs/ca.crt";
     constexpr char TLS_CLIENT_CERT_PATH[] = "/certs/client.crt";
     constexpr char TLS_CLIENT_KEY_PATH[] = "/certs/client.key";
+    constexpr bool TLS_SESSION_RESUMPTION = true;
+    constexpr uint32_t TLS_SESSION_LIFETIME_S = 86400;
+    constexpr bool TLS_PERSIST_SESSIONS = false; // Opt-in: the cache holds tickets and resumption PSKs
+    constexpr char TLS_SESSION_CACHE_PATH[] = "/data/tls_sessions.bin";
+    constexpr char TLS_SESSION_KEY_PATH[] = "/certs/session_cache.key"; // 32-byte key sealing the cache
+    constexpr bool ENABLE_PAYLOAD_ENCRYPTION = false; // End-to-end AEAD on top of TLS
+    constexpr uint64_t PAYLOAD_KEY_ROTATION_MESSAGES = 1ULL << 24;
+    constexpr char PAYLOAD_BOOT_EPOCH_PATH[] = "/data/boot_epoch";
     
     // Communication configuration
     constexpr bool USE_MQTT = true;
@@ -42,16 +50,76 @@ namespace DeviceConfig {
     constexpr char MQTT_CLIENT_ID[] = "IOT_EDGE_DEVICE_001";
     constexpr char MQTT_USERNAME[] = ""; // To be loaded from secure storage
     constexpr char MQTT_PASSWORD[] = ""; // To be loaded from secure storage
+    constexpr char MQTT_REGIONAL_BROKER[] = ""; // Telemetry mirror, empty to disable
+    constexpr uint16_t MQTT_REGIONAL_PORT = 8883;
+    constexpr uint8_t MQTT_CONNECTIONS_PER_BROKER = 1;
+    constexpr uint16_t MQTT_PUBLISH_QUEUE_DEPTH = 64; // Per connection
     constexpr char MQTT_TOPIC_TELEMETRY[] = "devices/data";
     constexpr char MQTT_TOPIC_COMMANDS[] = "devices/commands";
+    constexpr char MQTT_TOPIC_COMMANDS_FILTER[] = "devices/commands/#"; // Commands and their sub-topics
     constexpr char MQTT_TOPIC_STATUS[] = "devices/status";
+    constexpr char MQTT_TOPIC_TELEMETRY_DELTA[] = "devices/data/delta";
+    constexpr char MQTT_TOPIC_HISTORY_REQUEST[] = "devices/commands/history";
+    constexpr char MQTT_TOPIC_HISTORY[] = "devices/history";
+    constexpr char MQTT_TOPIC_CONFIG[] = "devices/commands/config";
+    constexpr char MQTT_TOPIC_RULES[] = "devices/commands/rules";
+    constexpr char MQTT_TOPIC_ALERTS[] = "devices/alerts";
+    constexpr uint16_t COMMAND_QUEUE_DEPTH = 32;
+    constexpr uint16_t COMMAND_MAX_MESSAGE_SIZE = 2048; // Topic plus payload
+    constexpr uint32_t COMMAND_MAX_LARGE_MESSAGE_SIZE = 65536; // Config and rule set uploads
+    constexpr uint8_t COMMAND_LARGE_SLOT_COUNT = 2;
+    constexpr char COAP_SERVER[] = "coap.example.com";
+    constexpr uint16_t COAP_PORT = 5684; // DTLS port
+    constexpr bool COAP_USE_DTLS = true;
+    constexpr char COAP_PSK_IDENTITY_PATH[] = "/certs/coap_psk_identity"; // PSK if present, else certs
+    constexpr char COAP_PSK_KEY_PATH[] = "/certs/coap_psk.key";
+    constexpr char COAP_URI_TELEMETRY[] = "devices/data";
+    constexpr char COAP_URI_COMMANDS[] = "devices/commands";
+    constexpr char COAP_URI_STATUS[] = "devices/status";
+    constexpr uint32_t UPLINK_BYTES_PER_SEC = 16384; // 0 = unlimited
+    constexpr uint32_t UPLINK_MESSAGES_PER_SEC = 50; // 0 = unlimited
+    constexpr uint8_t UPLINK_CONTROL_RESERVE_PERCENT = 20;
+    constexpr uint32_t OUTBOX_MAX_BYTES = 262144;
+    constexpr uint16_t BUFFER_SEGMENT_SIZE = 2048;
+    // A full outbox plus in-flight and serialization chains
+    constexpr uint16_t BUFFER_SEGMENT_COUNT = 3 * (OUTBOX_MAX_BYTES / BUFFER_SEGMENT_SIZE);
+    constexpr uint16_t CONTROL_SEGMENT_COUNT = 32; // Separate pool for CRITICAL and status payloads
+    constexpr uint32_t MQTT_ZEROCOPY_THRESHOLD = 16384; // MSG_ZEROCOPY only pays off for large sends
+    constexpr uint16_t DELIVERY_MAX_IN_FLIGHT = 256; // Published messages awaiting acknowledgement
+    constexpr uint16_t COAP_BLOCK_SIZE = 512; // Block-wise transfer block size in bytes
+    
+    // Sensors
+    constexpr uint16_t MAX_SENSORS = 4096; // Sensors per process, bounds the dense index tables
     
     // Data processing
     constexpr uint32_t DEFAULT_SAMPLING_RATE_MS = 1000;
     constexpr uint16_t DEFAULT_BUFFER_SIZE = 64;
     constexpr uint16_t DATA_BATCH_SIZE = 10;
+    constexpr char RULES_PATH[] = "/data/rules.txt";
+    constexpr uint8_t RULES_MAX_REGISTERS = 16;
+    constexpr uint32_t RULES_DEFAULT_INTERVAL_MS = 60000; // Rules without "every" fire at most once a minute
+    constexpr bool ENABLE_DELTA_TELEMETRY = false;
+    constexpr uint32_t DELTA_KEYFRAME_INTERVAL = 60; // Frames between keyframes
+    constexpr uint16_t DELTA_MAX_PENDING_FRAMES = 32;
     constexpr bool ENABLE_LOCAL_STORAGE = true;
     constexpr char LOCAL_STORAGE_PATH[] = "/data/";
+    constexpr char RUNTIME_CONFIG_PATH[] = "/data/runtime_config.json";
+    constexpr uint16_t TS_CHUNK_MAX_POINTS = 1024;
+    constexpr uint32_t TS_CHUNK_MAX_SPAN_MS = 600000;
+    constexpr uint32_t TS_CHUNK_MAX_BYTES = 16384;
+    constexpr uint32_t TS_SEGMENT_SIZE_KB = 4096;
+    constexpr uint32_t TS_RETENTION_MAX_SIZE_KB = 262144;
+    constexpr uint32_t TS_RETENTION_MAX_AGE_H = 720;
+    constexpr bool ENABLE_JOURNAL = true;
+    constexpr char JOURNAL_PATH[] = "/data/journal/";
+    constexpr uint32_t JOURNAL_SYNC_INTERVAL_MS = 2000; // Bounds data loss on crash
+    constexpr uint32_t JOURNAL_SYNC_BYTES = 65536;
+    constexpr uint32_t JOURNAL_SEGMENT_SIZE_KB = 1024;
+    constexpr uint32_t JOURNAL_COMPLETION_WINDOW = 65536; // LSNs tracked above the checkpoint
+    constexpr uint32_t HISTORY_MAX_POINTS = 5000; // Per query, also caps the bucket count
+    constexpr uint32_t HISTORY_MIN_BUCKET_MS = 1000;
+    constexpr uint16_t HISTORY_POINTS_PER_MESSAGE = 500;
+    constexpr uint32_t HISTORY_LTTB_MAX_INPUT = 20000; // Readings held in memory for one LTTB query
     
     // Power management
     constexpr bool ENABLE_LOW_POWER_MODE = true;
@@ -62,9 +130,40 @@ namespace DeviceConfig {
     
     // System
     constexpr uint32_t WATCHDOG_TIMEOUT_MS = 60000;
+    constexpr char WATCHDOG_DEVICE[] = "/dev/watchdog";
+    constexpr uint32_t SUPERVISOR_CHECK_INTERVAL_MS = 1000;
+    constexpr uint32_t SUPERVISOR_RESTART_WINDOW_MS = 600000;
+    constexpr uint32_t SUPERVISOR_RESTART_TIMEOUT_MS = 30000; // Petting stops if a restart takes longer
+    constexpr uint32_t TRACE_SAMPLE_RATE = 100; // Trace one in N readings, 0 disables tracing
+    constexpr uint16_t TRACE_MAX_IN_FLIGHT = 256;
+    constexpr uint8_t TRACE_MAX_PER_MESSAGE = 4; // Further traced readings in a message are abandoned
+    constexpr char TRACE_DUMP_PATH[] = "/data/latency_trace.txt";
+    constexpr uint32_t TRACE_RECORD_MAX_SIZE_KB = 65536; // Reading stream recordings
     constexpr bool ENABLE_ERROR_REPORTING = true;
     constexpr uint8_t MAX_RETRY_COUNT = 3;
     constexpr uint16_t ERROR_LOG_SIZE = 50;
+    constexpr uint8_t STARTUP_MAX_PARALLEL_BUSES = 8;
+    constexpr bool STARTUP_DEFER_SELF_TEST = true;
+    constexpr char CALIBRATION_CACHE_PATH[] = "/data/calibration/";
+    constexpr uint32_t CALIBRATION_CACHE_MAX_AGE_H = 168;
+    constexpr uint32_t ERROR_AGGREGATION_WINDOW_MS = 60000;
+    constexpr uint32_t STATUS_INTERVAL_MS = 30000;
+    constexpr uint32_t STATUS_FULL_SNAPSHOT_INTERVAL = 20; // Status intervals between full snapshots
+    constexpr uint16_t STATUS_MAX_FIELDS = MAX_SENSORS + 256; // One state field per sensor + counters
+    constexpr uint8_t STATUS_MAX_IN_FLIGHT = 4; // Status updates awaiting delivery
+    
+    // Local metrics endpoint (OpenMetrics text format)
+    constexpr bool ENABLE_METRICS_ENDPOINT = true;
+    constexpr char METRICS_BIND_ADDRESS[] = "127.0.0.1"; // Loopback only; empty to disable the HTTP listener
+    constexpr uint16_t METRICS_HTTP_PORT = 9464;
+    constexpr char METRICS_UNIX_SOCKET[] = "/run/iot-edge/metrics.sock"; // Empty to disable
+    constexpr uint16_t METRICS_MAX_SLOTS = 2 * MAX_SENSORS + 512; // Per thread: 2 per sensor + pipeline
+    
+    // Pipeline benchmarks
+    constexpr uint32_t BENCHMARK_MIN_TIME_MS = 200;
+    constexpr uint8_t BENCHMARK_REPETITIONS = 5;
+    constexpr char BENCHMARK_BASELINE_PATH[] = "/data/benchmark_baseline.json";
+    constexpr float BENCHMARK_TOLERANCE_PERCENT = 10.0f;
     
     // Logging
     enum class LogLevel {
@@ -80,6 +179,10 @@ namespace DeviceConfig {
     constexpr bool LOG_TO_FILE = true;
     constexpr char LOG_FILE_PATH[] = "/logs/device.log";
     constexpr uint32_t MAX_LOG_FILE_SIZE_KB = 1024;
+    constexpr uint8_t MAX_LOG_FILES = 3; // Rotated files kept besides the active one
+    constexpr uint16_t LOG_RING_CAPACITY = 1024; // Records per logging thread
+    constexpr uint32_t LOG_FLUSH_INTERVAL_MS = 100;
+    constexpr uint32_t LOG_HOT_PATH_EVERY_N = 100; // Repeated hot-path events logged once per this many
 }
 
 #endif // CONFIG_H
@@ -0,0 +1,54 @@
+/**
+ * @file cpu_features.h
+ * @brief Runtime detection of CPU features relevant to the firmware
+ * 
+ * This file provides helpers for querying instruction set extensions
+ * at runtime so that crypto and data paths can select the fastest
+ * implementation available on the target core.
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+namespace System {
+
+/**
+ * @brief Check if the CPU provides hardware AES instructions
+ * 
+ * Detects AES-NI on x86 and the ARMv8 Cryptography Extensions on ARM.
+ * Cores without AES acceleration (e.g. Cortex-A7, Cortex-A53 without
+ * the crypto option) run ChaCha20 considerably faster than AES-GCM.
+ * 
+ * @return true if hardware AES is available, false otherwise
+ */
+inline bool hasHardwareAES() {
+    static const bool sHasAES = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+            return false;
+        }
+        return (ecx & bit_AES) != 0;
+#elif defined(__linux__) && defined(__aarch64__)
+        return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#elif defined(__linux__) && defined(__arm__)
+        return (getauxval(AT_HWCAP2) & HWCAP2_AES) != 0;
+#else
+        return false;
+#endif
+    }();
+    return sHasAES;
+}
+
+} // namespace System
+
+#endif // CPU_FEATURES_H
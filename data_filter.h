@@ -13,7 +13,10 @@
 #include <string>
 #include <vector>
 #include <deque>
+#include <map>
+#include <limits>
 #include "../sensors/sensor_base.h"
+#include "../system/metrics_registry.h"
 
 namespace Data {
 
@@ -71,11 +74,25 @@ public:
      * @param enabled Whether to enable the filter
      */
     void setEnabled(bool enabled);
+    
+    /**
+     * @brief Apply runtime parameters
+     * 
+     * Called when the runtime configuration carries parameters for
+     * this filter's ID. The default implementation accepts only
+     * "enabled".
+     * 
+     * @param params Parameters by name
+     * @return true if all parameters were recognized and valid, false otherwise
+     */
+    virtual bool configure(const std::map<std::string, float>& params);
 
 protected:
     std::string mId;       ///< Unique filter identifier
     std::string mName;     ///< Human-readable name
     bool mEnabled;         ///< Whether the filter is enabled
+    System::Counter mInMetric;      ///< filter_readings_in_total{filter="<id>"}
+    System::Counter mDroppedMetric; ///< filter_readings_dropped_total{filter="<id>"}
 };
 
 /**
@@ -108,6 +125,14 @@ public:
     std::vector<Sensors::SensorReading> apply(
         const std::vector<Sensors::SensorReading>& readings) override;
     
+    /**
+     * @brief Apply runtime parameters
+     * 
+     * @param params Parameters by name, e.g. {"windowSize": 8}
+     * @return true if all parameters were recognized and valid, false otherwise
+     */
+    bool configure(const std::map<std::string, float>& params) override;
+    
     /**
      * @brief Set window size
      * 
@@ -129,7 +154,7 @@ public:
 
 private:
     size_t mWindowSize;    ///< Size of the moving average window
-    std::map<uint8_t, std::deque<std::vector<float>>> mHistory;  ///< History of values per sensor
+    Sensors::SensorTable<std::deque<std::vector<float>>> mHistory;  ///< History of values per sensor
     
     /**
      * @brief Calculate moving average for a single reading
@@ -174,6 +199,14 @@ public:
     std::vector<Sensors::SensorReading> apply(
         const std::vector<Sensors::SensorReading>& readings) override;
     
+    /**
+     * @brief Apply runtime parameters
+     * 
+     * @param params Parameters by name, e.g. {"min": -40, "max": 85}
+     * @return true if all parameters were recognized and valid, false otherwise
+     */
+    bool configure(const std::map<std::string, float>& params) override;
+    
     /**
      * @brief Set minimum threshold
      * 
@@ -245,6 +278,14 @@ public:
     std::vector<Sensors::SensorReading> apply(
         const std::vector<Sensors::SensorReading>& readings) override;
     
+    /**
+     * @brief Apply runtime parameters
+     * 
+     * @param params Parameters by name, e.g. {"minDelta": 0.5}
+     * @return true if all parameters were recognized and valid, false otherwise
+     */
+    bool configure(const std::map<std::string, float>& params) override;
+    
     /**
      * @brief Set minimum delta
      * 
@@ -266,7 +307,7 @@ public:
 
 private:
     float mMinDelta;   ///< Minimum change required to pass filter
-    std::map<uint8_t, std::vector<float>> mLastValues;  ///< Last values per sensor
+    Sensors::SensorTable<std::vector<float>> mLastValues;  ///< Last values per sensor
     
     /**
      * @brief Check if reading has changed by more than minDelta
@@ -307,6 +348,14 @@ public:
     std::vector<Sensors::SensorReading> apply(
         const std::vector<Sensors::SensorReading>& readings) override;
     
+    /**
+     * @brief Apply runtime parameters
+     * 
+     * @param params Parameters by name, e.g. {"windowSize": 8}
+     * @return true if all parameters were recognized and valid, false otherwise
+     */
+    bool configure(const std::map<std::string, float>& params) override;
+    
     /**
      * @brief Set window size
      * 
@@ -328,7 +377,7 @@ public:
 
 private:
     size_t mWindowSize;    ///< Size of the median filter window
-    std::map<uint8_t, std::deque<std::vector<float>>> mHistory;  ///< History of values per sensor
+    Sensors::SensorTable<std::deque<std::vector<float>>> mHistory;  ///< History of values per sensor
     
     /**
      * @brief Calculate median for a single reading
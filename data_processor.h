@@ -13,8 +13,17 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <map>
+#include <atomic>
+#include <mutex>
 #include "../sensors/sensor_base.h"
+#include "../system/runtime_config.h"
+#include "../system/latency_tracer.h"
+#include "../system/logger.h"
+#include "../system/metrics_registry.h"
+#include "../storage/write_ahead_journal.h"
 #include "data_filter.h"
+#include "rules_engine.h"
 
 namespace Data {
 
@@ -68,6 +77,10 @@ public:
     /**
      * @brief Process sensor readings
      * 
+     * With a journal attached, readings the filters drop are completed
+     * in it right away; the readings returned keep their journalLsn and
+     * are completed once delivered.
+     * 
      * @param readings Vector of sensor readings to process
      * @return Processing result with processed readings
      */
@@ -93,9 +106,50 @@ public:
      */
     void clearFilters();
     
+    /**
+     * @brief Apply a runtime configuration snapshot
+     * 
+     * Passes filter parameters to the filters with matching IDs and
+     * takes over the batch size. Called from a ConfigManager subscription;
+     * safe to run concurrently with process().
+     * 
+     * @param config New configuration snapshot
+     * @return true if every filter accepted its parameters, false otherwise
+     */
+    bool applyConfig(const System::RuntimeConfig& config);
+    
+    /**
+     * @brief Stamp traced readings with FILTERED after the filters ran
+     * 
+     * @param tracer Latency tracer, or nullptr to disable
+     */
+    void setTracer(std::shared_ptr<System::LatencyTracer> tracer);
+    
+    /**
+     * @brief Evaluate edge rules on the filtered readings of each batch
+     * 
+     * @param rules Rules engine, or nullptr to disable
+     */
+    void setRulesEngine(std::shared_ptr<RulesEngine> rules);
+    
+    /**
+     * @brief Complete consumed readings in the write-ahead journal
+     * 
+     * The acquisition loop journals every reading before processing, so
+     * the processor completes the readings it consumes: those dropped by
+     * a filter, and the inputs of an aggregate once the aggregate itself
+     * is appended. Without a journal nothing is completed.
+     * 
+     * @param journal Journal the acquisition loop appends to, or nullptr
+     */
+    void attachJournal(std::shared_ptr<Storage::WriteAheadJournal> journal);
+    
     /**
      * @brief Aggregate multiple readings into one
      * 
+     * With a journal attached, the aggregate is appended and carries the
+     * new LSN, and the inputs are completed.
+     * 
      * @param readings Vector of sensor readings to aggregate
      * @param method Aggregation method (avg, min, max, sum)
      * @return Aggregated sensor reading
@@ -136,10 +190,24 @@ public:
 private:
     std::vector<std::shared_ptr<DataFilter>> mFilters; ///< Processing filters
     bool mInitialized;  ///< Initialization state
+    std::atomic<uint16_t> mBatchSize; ///< Readings per batch, from the runtime configuration
+    std::mutex mFiltersMutex; ///< Guards mFilters against live reconfiguration
+    std::shared_ptr<System::LatencyTracer> mTracer; ///< Optional latency tracer
+    std::shared_ptr<RulesEngine> mRules; ///< Optional edge rules
+    std::shared_ptr<Storage::WriteAheadJournal> mJournal; ///< Optional journal for consumed readings
+    System::Counter mReadingsInMetric;     ///< processor_readings_in_total
+    System::Counter mReadingsOutMetric;    ///< processor_readings_out_total
+    System::Counter mAnomaliesMetric;      ///< processor_anomalies_total
+    System::Histogram mProcessDurationMetric; ///< processor_process_duration_us
+    System::Histogram mCompressRatioMetric;   ///< processor_compress_ratio
     
     /**
      * @brief Apply all filters to the readings
      * 
+     * Logs at DEBUG, with LOG_EVERY_N, the filter ID and how many
+     * readings it removed whenever a filter drops any, and completes the
+     * journal LSNs of the removed readings.
+     * 
      * @param readings Readings to filter
      * @return Filtered readings
      */
@@ -0,0 +1,187 @@
+/**
+ * @file delta_encoder.h
+ * @brief Delta encoding of telemetry against last-acknowledged state
+ * 
+ * This file provides an encoder that transmits only the channels that
+ * changed since the last state acknowledged by the broker, plus a
+ * matching decoder for the platform side.
+ * 
+ * Frame layout (all integers little endian):
+ * 
+ *   | version (1) | flags (1) | sequence (4) | baseSequence (4) |
+ *   | baseTimestamp (8) | recordCount (2) | records... |
+ * 
+ * flags bit 0 marks a keyframe. baseSequence is the sequence of the
+ * acknowledged frame the delta is relative to (0 for keyframes).
+ * 
+ * Record layout:
+ * 
+ *   | sensorId (varint) | channelCount (1) | timestampDelta (varint, ms) |
+ *   | bitmask (ceil(channelCount / 8)) | float32 value per set bit |
+ * 
+ * A record whose sensor has no acknowledged state, or whose channel
+ * count changed, is always sent with every bit set.
+ */
+
+#ifndef DELTA_ENCODER_H
+#define DELTA_ENCODER_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+
+namespace Communication {
+
+/**
+ * @brief Delta encoder statistics
+ */
+struct DeltaEncoderStats {
+    uint64_t frames;           ///< Frames encoded
+    uint64_t keyframes;        ///< Keyframes encoded
+    uint64_t channelsTotal;    ///< Channels presented to the encoder
+    uint64_t channelsSent;     ///< Channels actually transmitted
+    uint64_t bytesEncoded;     ///< Total encoded bytes
+    
+    DeltaEncoderStats()
+        : frames(0), keyframes(0), channelsTotal(0), channelsSent(0), bytesEncoded(0) {}
+};
+
+/**
+ * @brief Delta encoder class
+ */
+class DeltaEncoder {
+public:
+    static constexpr uint8_t FORMAT_VERSION = 2;
+    static constexpr uint8_t FLAG_KEYFRAME = 0x01;
+    
+    /**
+     * @brief Constructor
+     * 
+     * @param keyframeInterval Send a keyframe every this many frames
+     * @param maxPendingFrames Maximum unacknowledged frames kept for promotion
+     */
+    DeltaEncoder(
+        uint32_t keyframeInterval = DeviceConfig::DELTA_KEYFRAME_INTERVAL,
+        size_t maxPendingFrames = DeviceConfig::DELTA_MAX_PENDING_FRAMES
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~DeltaEncoder();
+    
+    /**
+     * @brief Encode readings into a frame
+     * 
+     * Channels are compared bitwise with the last acknowledged value, so a
+     * lost frame is corrected by the next one without retransmission.
+     * 
+     * @param readings Readings to encode
+     * @param out Buffer to append the frame to (cleared first)
+     * @return Sequence number of the frame
+     */
+    uint32_t encode(const std::vector<Sensors::SensorReading>& readings, std::vector<uint8_t>& out);
+    
+    /**
+     * @brief Promote the state carried by a frame to acknowledged
+     * 
+     * The frame's full reconstructed snapshot (its base snapshot from
+     * mBases plus its recorded changes, i.e. exactly the decoder's state
+     * for that sequence) becomes the base of later frames. Acks may
+     * arrive in any order; an ack for a frame older than the current
+     * base is ignored. Base snapshots no pending frame refers to any
+     * more are freed.
+     * 
+     * @param sequence Sequence number returned by encode()
+     */
+    void onAcknowledged(uint32_t sequence);
+    
+    /**
+     * @brief Drop all acknowledged state and force a keyframe
+     * 
+     * Called after reconnecting or when the platform asks for a resync.
+     * Every keyframe also drops the acknowledged state, since the decoder
+     * evicts states older than its last keyframe; frames stay full until
+     * the keyframe or a later frame is acknowledged.
+     */
+    void requestKeyframe();
+    
+    /**
+     * @brief Get encoder statistics
+     * 
+     * @return Encoder statistics
+     */
+    DeltaEncoderStats getStats() const;
+
+private:
+    /**
+     * @brief Channel values sent in a frame, per sensor
+     */
+    using Snapshot = std::map<Sensors::SensorId, std::vector<float>>;
+    
+    /**
+     * @brief Unacknowledged frame
+     */
+    struct PendingFrame {
+        uint32_t baseSequence;   ///< Acknowledged frame the changes are relative to, 0 for full
+        Snapshot changes;        ///< Channel values sent in the frame, changed ones only
+        
+        PendingFrame() : baseSequence(0), changes() {}
+    };
+    
+    uint32_t mKeyframeInterval;
+    size_t mMaxPendingFrames;
+    uint32_t mNextSequence;
+    uint32_t mAckedSequence;
+    uint32_t mFramesSinceKeyframe;
+    bool mForceKeyframe;
+    std::map<uint32_t, Snapshot> mBases;      ///< Snapshots of mAckedSequence and older referenced bases
+    std::map<uint32_t, PendingFrame> mPending; ///< Changes per unacknowledged frame
+    DeltaEncoderStats mStats;
+};
+
+/**
+ * @brief Delta decoder class
+ * 
+ * Reference decoder for the platform side. It keeps the reconstructed
+ * state per device and must acknowledge frames in the same order it
+ * applies them. Only the last keyframe's state and at most
+ * maxStates - 1 later states are kept; a keyframe evicts everything
+ * older, and a frame whose base was evicted fails to decode, upon
+ * which the platform requests a keyframe.
+ */
+class DeltaDecoder {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param maxStates Maximum reconstructed states kept
+     */
+    explicit DeltaDecoder(size_t maxStates = DeviceConfig::DELTA_MAX_PENDING_FRAMES + 1);
+    
+    /**
+     * @brief Destructor
+     */
+    ~DeltaDecoder();
+    
+    /**
+     * @brief Decode a frame into full readings
+     * 
+     * @param data Frame bytes
+     * @param length Frame length
+     * @param readings Vector to store the reconstructed readings
+     * @return false if the frame is malformed or refers to an unknown base
+     */
+    bool decode(const uint8_t* data, size_t length, std::vector<Sensors::SensorReading>& readings);
+
+private:
+    size_t mMaxStates;
+    uint32_t mKeyframeSequence;  ///< Sequence of the last keyframe, never evicted
+    std::map<uint32_t, std::map<Sensors::SensorId, std::vector<float>>> mStates; ///< Reconstructed state by sequence
+};
+
+} // namespace Communication
+
+#endif // DELTA_ENCODER_H
@@ -0,0 +1,140 @@
+/**
+ * @file error_aggregator.h
+ * @brief Deduplication and rate limiting of error reports
+ * 
+ * This file provides an aggregation stage that coalesces repeated
+ * errors from the same source into counted summaries over a window,
+ * so a flapping sensor produces one report per window instead of one
+ * per failure.
+ */
+
+#ifndef ERROR_AGGREGATOR_H
+#define ERROR_AGGREGATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_registry.h"
+#include "../system/error_handler.h"
+
+namespace Communication {
+
+/**
+ * @brief Aggregated error entry
+ */
+struct ErrorSummary {
+    static constexpr size_t MAX_MESSAGE_LENGTH = 96;
+    
+    System::ErrorCode code;   ///< Error code
+    Sensors::SensorId sensorId; ///< Originating sensor, ErrorAggregator::NO_SENSOR if none
+    uint32_t count;           ///< Occurrences not yet reported
+    uint32_t totalCount;      ///< Occurrences since the entry was created
+    uint64_t firstSeen;       ///< First occurrence in the current window (ms)
+    uint64_t lastSeen;        ///< Most recent occurrence (ms)
+    char message[MAX_MESSAGE_LENGTH]; ///< Message of the most recent occurrence, truncated
+    bool active;              ///< Whether the slot is in use
+    
+    ErrorSummary()
+        : code(), sensorId(Sensors::INVALID_SENSOR_ID), count(0), totalCount(0),
+          firstSeen(0), lastSeen(0), message(), active(false) {}
+};
+
+/**
+ * @brief Summary emission callback type
+ * 
+ * Receives the entry and whether it is the first occurrence (sent
+ * immediately) or a windowed summary of repeats.
+ */
+using ErrorSummaryCallback = std::function<void(const ErrorSummary&, bool)>;
+
+/**
+ * @brief Error aggregator class
+ * 
+ * Entries live in a fixed table of ERROR_LOG_SIZE slots keyed on
+ * (ErrorCode, sensorId). The first occurrence of a key is emitted at
+ * once; repeats are only counted and emitted as one summary when the
+ * window closes. When the table is full the entry with the oldest
+ * lastSeen is flushed and reused (LRU).
+ */
+class ErrorAggregator {
+public:
+    static constexpr Sensors::SensorId NO_SENSOR = Sensors::INVALID_SENSOR_ID;
+    
+    /**
+     * @brief Constructor
+     * 
+     * @param windowMs Aggregation window in milliseconds
+     * @param capacity Number of distinct keys tracked
+     */
+    ErrorAggregator(
+        uint32_t windowMs = DeviceConfig::ERROR_AGGREGATION_WINDOW_MS,
+        size_t capacity = DeviceConfig::ERROR_LOG_SIZE
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~ErrorAggregator();
+    
+    /**
+     * @brief Record an error occurrence
+     * 
+     * Does not allocate; the message is truncated into the slot.
+     * 
+     * @param code Error code
+     * @param sensorId Originating sensor, or NO_SENSOR
+     * @param message Error message
+     * @param nowMs Current time in milliseconds
+     * @param emit Callback for the first occurrence or an evicted entry
+     */
+    void record(System::ErrorCode code, Sensors::SensorId sensorId, const std::string& message,
+                uint64_t nowMs, const ErrorSummaryCallback& emit);
+    
+    /**
+     * @brief Emit summaries for entries whose window has closed
+     * 
+     * @param nowMs Current time in milliseconds
+     * @param emit Callback for each summary
+     * @return Number of summaries emitted
+     */
+    size_t flush(uint64_t nowMs, const ErrorSummaryCallback& emit);
+    
+    /**
+     * @brief Get the number of occurrences suppressed so far
+     * 
+     * @return Suppressed occurrences
+     */
+    uint64_t getSuppressedCount() const;
+
+private:
+    uint32_t mWindowMs;
+    std::vector<ErrorSummary> mEntries;   ///< Fixed table, sized once in the constructor
+    uint64_t mSuppressed;
+    std::mutex mMutex;
+    
+    /**
+     * @brief Find the slot for a key
+     * 
+     * @param code Error code
+     * @param sensorId Sensor identifier
+     * @return Slot index, or mEntries.size() if not present
+     */
+    size_t find(System::ErrorCode code, Sensors::SensorId sensorId) const;
+    
+    /**
+     * @brief Pick the slot for a new key
+     * 
+     * Scans the table once; ERROR_LOG_SIZE is small enough that this
+     * beats maintaining a recency list on every record().
+     * 
+     * @return First free slot, or the active slot with the oldest lastSeen
+     */
+    size_t findVictim() const;
+};
+
+} // namespace Communication
+
+#endif // ERROR_AGGREGATOR_H
@@ -176,7 +176,7 @@ public:
      * @param name Human-readable name of the sensor
      * @param pins Vector of pin numbers to use
      */
-    GPIOSensor(uint8_t id, 
+    GPIOSensor(SensorId id, 
                const std::string& name,
                const std::vector<uint8_t>& pins);
     
@@ -193,11 +193,11 @@ public:
     bool initialize() override;
     
     /**
-     * @brief Read data from the GPIO sensor
+     * @brief Read raw data from the GPIO sensor
      * 
-     * @return SensorReading object containing the measured values
+     * @return SensorReading object containing the uncalibrated values
      */
-    SensorReading read() override;
+    SensorReading readRaw() override;
     
     /**
      * @brief Calibrate the GPIO sensor
@@ -227,6 +227,13 @@ public:
      */
     bool selfTest() override;
     
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * @return "gpio"
+     */
+    std::string getBusKey() const override;
+    
     /**
      * @brief Configure a specific GPIO pin
      * 
@@ -0,0 +1,252 @@
+/**
+ * @file health_supervisor.h
+ * @brief Pipeline health supervision and hardware watchdog integration
+ * 
+ * This file provides a supervisor that tracks heartbeats from the
+ * pipeline stages (acquisition, processing, communication), measures
+ * their loop latency against per-stage deadlines, restarts a stalled
+ * stage, and pets the Linux watchdog only while every stage is healthy.
+ */
+
+#ifndef HEALTH_SUPERVISOR_H
+#define HEALTH_SUPERVISOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../system/error_handler.h"
+
+namespace Communication {
+class DeviceStatusRegistry;
+}
+
+namespace System {
+
+/**
+ * @brief Handle of a supervised stage
+ */
+using StageId = uint8_t;
+
+/**
+ * @brief Health of a supervised stage
+ */
+enum class StageHealth {
+    HEALTHY,     ///< Heartbeats arrive within the deadline
+    LATE,        ///< Last loop exceeded the deadline
+    STALLED,     ///< No heartbeat for longer than the stall timeout
+    RESTARTING   ///< Restart callback is running
+};
+
+/**
+ * @brief Stage restart callback type
+ * 
+ * Stops and restarts the stage's thread; returns true on success.
+ */
+using StageRestartCallback = std::function<bool()>;
+
+/**
+ * @brief Statistics of a supervised stage
+ */
+struct StageStats {
+    std::string name;          ///< Stage name
+    StageHealth health;        ///< Current health
+    uint32_t deadlineMs;       ///< Loop deadline
+    uint32_t lastLatencyMs;    ///< Duration of the last loop iteration
+    uint32_t maxLatencyMs;     ///< Longest loop iteration
+    uint64_t iterations;       ///< Completed loop iterations
+    uint64_t deadlineMisses;   ///< Iterations that exceeded the deadline
+    uint32_t stalls;           ///< Times the stage was found stalled
+    uint32_t restarts;         ///< Restarts performed
+    
+    StageStats()
+        : name(), health(StageHealth::HEALTHY), deadlineMs(0), lastLatencyMs(0),
+          maxLatencyMs(0), iterations(0), deadlineMisses(0), stalls(0), restarts(0) {}
+};
+
+/**
+ * @brief Health supervisor class
+ * 
+ * Stages call beginIteration()/endIteration() (or heartbeat() for loops
+ * without a clear iteration) from their own thread; these are single
+ * atomic stores. The supervisor thread evaluates all stages every
+ * SUPERVISOR_CHECK_INTERVAL_MS and pets the watchdog. Restart callbacks
+ * may block while they join the old thread, so they run on a separate
+ * restart thread; a RESTARTING stage does not stop the petting until it
+ * has been restarting for SUPERVISOR_RESTART_TIMEOUT_MS.
+ */
+class HealthSupervisor {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param watchdogDevice Watchdog device, empty to run without one
+     * @param watchdogTimeoutMs Hardware watchdog timeout
+     */
+    HealthSupervisor(
+        const std::string& watchdogDevice = DeviceConfig::WATCHDOG_DEVICE,
+        uint32_t watchdogTimeoutMs = DeviceConfig::WATCHDOG_TIMEOUT_MS
+    );
+    
+    /**
+     * @brief Destructor, stops supervision and disarms the watchdog
+     */
+    ~HealthSupervisor();
+    
+    /**
+     * @brief Register a stage
+     * 
+     * Must be called before start().
+     * 
+     * @param name Stage name, e.g. "acquisition"
+     * @param deadlineMs Expected maximum loop duration
+     * @param stallTimeoutMs Time without heartbeat after which the stage is restarted
+     * @param restart Callback restarting the stage, may be empty
+     * @return Stage handle
+     */
+    StageId registerStage(const std::string& name, uint32_t deadlineMs,
+                          uint32_t stallTimeoutMs, StageRestartCallback restart);
+    
+    /**
+     * @brief Open the watchdog and start the supervisor thread
+     * 
+     * Sets the watchdog timeout with WDIOC_SETTIMEOUT. Works with the
+     * softdog module on development machines.
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool start();
+    
+    /**
+     * @brief Stop supervision
+     * 
+     * Writes the magic close character so the watchdog is disarmed
+     * rather than firing.
+     */
+    void stop();
+    
+    /**
+     * @brief Mark the start of a loop iteration
+     * 
+     * @param stage Stage handle
+     */
+    void beginIteration(StageId stage);
+    
+    /**
+     * @brief Mark the end of a loop iteration and record its latency
+     * 
+     * @param stage Stage handle
+     */
+    void endIteration(StageId stage);
+    
+    /**
+     * @brief Signal that a stage is alive without measuring latency
+     * 
+     * @param stage Stage handle
+     */
+    void heartbeat(StageId stage);
+    
+    /**
+     * @brief Check if every stage is healthy
+     * 
+     * @return true if all stages are HEALTHY, false otherwise
+     */
+    bool isHealthy() const;
+    
+    /**
+     * @brief Get statistics of all stages
+     * 
+     * @return Vector of stage statistics
+     */
+    std::vector<StageStats> getStats() const;
+    
+    /**
+     * @brief Publish stage health and latency through the status registry
+     * 
+     * @param registry Status registry
+     */
+    void attachStatusRegistry(Communication::DeviceStatusRegistry& registry);
+
+private:
+    /**
+     * @brief Supervised stage state, updated lock-free by the stage thread
+     */
+    struct Stage {
+        std::string name;
+        uint32_t deadlineMs;
+        uint32_t stallTimeoutMs;
+        StageRestartCallback restart;
+        std::atomic<uint64_t> iterationStartMs;
+        std::atomic<uint64_t> lastHeartbeatMs;
+        std::atomic<uint32_t> lastLatencyMs;
+        std::atomic<uint32_t> maxLatencyMs;
+        std::atomic<uint64_t> iterations;
+        std::atomic<uint64_t> deadlineMisses;
+        std::atomic<StageHealth> health;
+        uint32_t stalls;
+        uint32_t restarts;
+        uint32_t recentRestarts;     ///< Restarts within the current restart window
+        uint64_t restartWindowStartMs;
+        std::atomic<uint64_t> restartStartedMs; ///< When the pending restart was queued
+    };
+    
+    std::string mWatchdogDevice;
+    uint32_t mWatchdogTimeoutMs;
+    int mWatchdogFd;
+    std::vector<std::unique_ptr<Stage>> mStages;
+    Communication::DeviceStatusRegistry* mStatusRegistry;
+    std::thread mThread;
+    std::thread mRestartThread;
+    std::deque<Stage*> mRestartQueue;         ///< Stages waiting for their restart callback
+    std::atomic<bool> mRunning;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::condition_variable mRestartCondition;
+    
+    /**
+     * @brief Supervisor thread loop
+     */
+    void supervisorLoop();
+    
+    /**
+     * @brief Restart thread loop
+     * 
+     * Runs the restart callbacks queued by evaluateStage() one at a time
+     * and sets the stage back to HEALTHY or STALLED depending on the result.
+     */
+    void restartLoop();
+    
+    /**
+     * @brief Evaluate one stage and restart it if stalled
+     * 
+     * A stalled stage is set to RESTARTING and queued for the restart
+     * thread; evaluation never calls the callback itself. A stage that
+     * needs more than MAX_RETRY_COUNT restarts within
+     * SUPERVISOR_RESTART_WINDOW_MS is left stalled, which stops the
+     * watchdog petting and lets the hardware reset the device.
+     * 
+     * @param stage Stage to evaluate
+     * @param nowMs Current time in milliseconds
+     * @return true if the stage is healthy, or restarting for less than
+     *         SUPERVISOR_RESTART_TIMEOUT_MS, false otherwise
+     */
+    bool evaluateStage(Stage& stage, uint64_t nowMs);
+    
+    /**
+     * @brief Pet the hardware watchdog
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool petWatchdog();
+};
+
+} // namespace System
+
+#endif // HEALTH_SUPERVISOR_H
@@ -0,0 +1,247 @@
+/**
+ * @file latency_tracer.h
+ * @brief Sampled end-to-end latency tracing of readings
+ * 
+ * This file provides lightweight tracing that follows a sample of
+ * readings from acquisition through filtering, serialization and
+ * publishing to the broker's acknowledgement, and aggregates the time
+ * spent between stages into histograms.
+ */
+
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+
+namespace Communication {
+class DeviceStatusRegistry;
+}
+
+namespace System {
+
+/**
+ * @brief Pipeline stages a reading passes through
+ */
+enum class TraceStage : uint8_t {
+    ACQUIRED = 0,      ///< begin() ran, right after acquisition
+    FILTERED = 1,      ///< DataProcessor filters applied
+    SERIALIZED = 2,    ///< Payload built
+    PUBLISHED = 3,     ///< Written to the socket by the publisher thread
+    ACKNOWLEDGED = 4,  ///< PUBACK received
+    COUNT = 5
+};
+
+/**
+ * @brief Log2-bucketed latency histogram
+ * 
+ * Bucket i counts latencies in [2^i, 2^(i+1)) microseconds. Recording
+ * is a single relaxed atomic increment.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 32;
+    
+    LatencyHistogram() : mBuckets(), mCount(0), mSumUs(0), mMaxUs(0) {}
+    
+    /**
+     * @brief Record a latency
+     * 
+     * @param latencyUs Latency in microseconds
+     */
+    void record(uint64_t latencyUs) {
+        size_t bucket = 0;
+        while (bucket + 1 < BUCKETS && (latencyUs >> (bucket + 1)) != 0) {
+            ++bucket;
+        }
+        mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        mCount.fetch_add(1, std::memory_order_relaxed);
+        mSumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+        uint64_t max = mMaxUs.load(std::memory_order_relaxed);
+        while (latencyUs > max &&
+               !mMaxUs.compare_exchange_weak(max, latencyUs, std::memory_order_relaxed)) {
+        }
+    }
+    
+    /**
+     * @brief Estimate a percentile from the buckets
+     * 
+     * @param percentile Percentile in [0, 100]
+     * @return Upper bound of the bucket containing the percentile, in microseconds
+     */
+    uint64_t percentile(double percentile) const;
+    
+    /**
+     * @brief Get the number of recorded latencies
+     * 
+     * @return Sample count
+     */
+    uint64_t count() const { return mCount.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Get the sum of recorded latencies
+     * 
+     * @return Sum in microseconds
+     */
+    uint64_t sumUs() const { return mSumUs.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Get the largest recorded latency
+     * 
+     * @return Maximum in microseconds
+     */
+    uint64_t maxUs() const { return mMaxUs.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Get the count of one bucket
+     * 
+     * @param bucket Bucket index
+     * @return Bucket count
+     */
+    uint64_t bucket(size_t bucket) const { return mBuckets[bucket].load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Clear the histogram
+     */
+    void reset();
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> mBuckets;
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSumUs;
+    std::atomic<uint64_t> mMaxUs;
+};
+
+/**
+ * @brief Latency tracer class
+ * 
+ * One in TRACE_SAMPLE_RATE readings gets a trace ID, stored in
+ * SensorReading::traceId; untraced readings cost one counter increment.
+ * Trace IDs index a fixed table of in-flight traces, so tracing never
+ * allocates and an ID whose slot was reused is recognized by its
+ * generation bits and ignored. Every stage, ACQUIRED included, is
+ * stamped with the tracer's own steady clock in microseconds.
+ */
+class LatencyTracer {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param sampleRate Trace one in this many readings, 0 to disable
+     * @param maxInFlight Number of concurrently traced readings
+     */
+    LatencyTracer(
+        uint32_t sampleRate = DeviceConfig::TRACE_SAMPLE_RATE,
+        size_t maxInFlight = DeviceConfig::TRACE_MAX_IN_FLIGHT
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~LatencyTracer();
+    
+    /**
+     * @brief Decide whether to trace a reading and start its trace
+     * 
+     * Sets reading.traceId for sampled readings and stamps ACQUIRED with
+     * the tracer clock. reading.timestamp is not used: it is wall-clock
+     * milliseconds, and replayed readings may keep their original time.
+     * 
+     * @param reading Freshly acquired reading
+     */
+    void begin(Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Stamp a stage for a trace
+     * 
+     * @param traceId Trace ID, 0 is ignored
+     * @param stage Stage reached
+     */
+    void mark(uint32_t traceId, TraceStage stage);
+    
+    /**
+     * @brief Stamp a stage for every traced reading in a batch
+     * 
+     * @param readings Readings of the batch
+     * @param stage Stage reached
+     */
+    void mark(const std::vector<Sensors::SensorReading>& readings, TraceStage stage);
+    
+    /**
+     * @brief Get the histogram of the time from one stage to the next
+     * 
+     * @param stage Stage the interval ends at (FILTERED..ACKNOWLEDGED)
+     * @return Histogram
+     */
+    const LatencyHistogram& getStageHistogram(TraceStage stage) const;
+    
+    /**
+     * @brief Get the histogram of acquisition-to-acknowledgement latency
+     * 
+     * @return Histogram
+     */
+    const LatencyHistogram& getEndToEndHistogram() const;
+    
+    /**
+     * @brief Register and update p50/p99/max fields per stage
+     * 
+     * Fields are named "latency.<stage>.p50_us" etc.
+     * 
+     * @param registry Status registry
+     */
+    void exportStatus(Communication::DeviceStatusRegistry& registry);
+    
+    /**
+     * @brief Write all histograms to a file
+     * 
+     * @param path File path
+     * @return true if successful, false otherwise
+     */
+    bool dumpToFile(const std::string& path = DeviceConfig::TRACE_DUMP_PATH) const;
+
+private:
+    struct Trace {
+        std::atomic<uint32_t> traceId;   ///< ID owning the slot, 0 if free
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(TraceStage::COUNT)> stampsUs;
+    };
+    
+    uint32_t mSampleRate;
+    std::atomic<uint64_t> mReadingCounter;
+    std::atomic<uint32_t> mNextGeneration;
+    size_t mMaxInFlight;
+    std::unique_ptr<Trace[]> mTraces;
+    std::array<LatencyHistogram, static_cast<size_t>(TraceStage::COUNT)> mStageHistograms;
+    LatencyHistogram mEndToEnd;
+    
+    /**
+     * @brief Find the slot of a live trace
+     * 
+     * @param traceId Trace ID
+     * @return Slot, or nullptr if the trace was evicted
+     */
+    Trace* find(uint32_t traceId) const;
+    
+    /**
+     * @brief Record the stage intervals of a completed trace and free it
+     * 
+     * @param trace Completed trace
+     */
+    void complete(Trace& trace);
+    
+    /**
+     * @brief Read the clock all stages are stamped with
+     * 
+     * @return std::chrono::steady_clock time in microseconds
+     */
+    static uint64_t nowUs();
+};
+
+} // namespace System
+
+#endif // LATENCY_TRACER_H
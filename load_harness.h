@@ -0,0 +1,155 @@
+/**
+ * @file load_harness.h
+ * @brief Scale-test harness driving fleets of synthetic sensors
+ * 
+ * This file provides a harness that instantiates many synthetic sensors
+ * and runs them through the acquisition scheduling, DataProcessor and
+ * CommManager, reporting how far acquisition fell behind schedule and
+ * the throughput of each stage.
+ */
+
+#ifndef LOAD_HARNESS_H
+#define LOAD_HARNESS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "../sensors/synthetic_sensor.h"
+#include "../data/data_processor.h"
+#include "../communication/comm_manager.h"
+#include "../system/latency_tracer.h"
+
+namespace System {
+
+/**
+ * @brief Fleet description
+ */
+struct FleetConfig {
+    uint16_t sensorCount;                    ///< Number of sensors to create, at most MAX_SENSORS
+    Sensors::SensorId firstSensorId;         ///< ID of the first sensor, IDs are consecutive
+    uint32_t samplingRateMs;                 ///< Sampling rate of every sensor
+    std::vector<Sensors::SignalConfig> channels; ///< Channel template, varied per sensor by seed
+    float failureRate;                       ///< read() failure probability
+    uint32_t seed;                           ///< Base random seed
+    
+    FleetConfig()
+        : sensorCount(100), firstSensorId(0), samplingRateMs(1000),
+          channels(1), failureRate(0.0f), seed(1) {}
+};
+
+/**
+ * @brief Harness results
+ */
+struct LoadStats {
+    uint64_t readings;          ///< Readings acquired
+    uint64_t failedReads;       ///< Invalid readings
+    uint64_t lateReads;         ///< Reads started more than one period late
+    uint64_t maxLatenessUs;     ///< Largest delay of a read behind its schedule
+    uint64_t processed;         ///< Readings returned by DataProcessor
+    uint64_t sent;              ///< Readings accepted by CommManager (SUCCESS or DEFERRED)
+    uint64_t sendFailures;      ///< Batches CommManager rejected
+    uint64_t durationMs;        ///< Wall time of the run
+    
+    LoadStats()
+        : readings(0), failedReads(0), lateReads(0), maxLatenessUs(0),
+          processed(0), sent(0), sendFailures(0), durationMs(0) {}
+};
+
+/**
+ * @brief Load harness class
+ */
+class LoadHarness {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param processor Processor readings are passed through, may be null
+     * @param comm Communication manager batches are sent with, may be null
+     */
+    LoadHarness(std::shared_ptr<Data::DataProcessor> processor = nullptr,
+                std::shared_ptr<Communication::CommManager> comm = nullptr);
+    
+    /**
+     * @brief Destructor, stops a running test
+     */
+    ~LoadHarness();
+    
+    /**
+     * @brief Create and initialize a fleet of synthetic sensors
+     * 
+     * The cap is the SensorRegistry capacity, MAX_SENSORS (4096), shared
+     * with sensors registered outside the fleet; a fleet that does not
+     * fit in the free registry slots is rejected before any sensor is
+     * created.
+     * 
+     * @param config Fleet description
+     * @return false if the fleet does not fit in the SensorRegistry or a
+     *         sensor failed to initialize
+     */
+    bool createFleet(const FleetConfig& config);
+    
+    /**
+     * @brief Add an existing sensor to the run
+     * 
+     * @param sensor Sensor
+     */
+    void addSensor(std::shared_ptr<Sensors::SensorBase> sensor);
+    
+    /**
+     * @brief Trace readings of the run end to end
+     * 
+     * Sets the tracer on every sensor, those created or added later
+     * included, and on the processor and communication manager.
+     * 
+     * @param tracer Latency tracer, or nullptr to disable
+     */
+    void setTracer(std::shared_ptr<LatencyTracer> tracer);
+    
+    /**
+     * @brief Acquire, process and send for a fixed time
+     * 
+     * Sensors are read on their sampling schedule by acquisitionThreads
+     * threads, and due readings are batched every batchIntervalMs.
+     * 
+     * @param durationMs Run time
+     * @param acquisitionThreads Threads reading sensors
+     * @param batchIntervalMs Interval between processing batches
+     * @return Statistics of the run
+     */
+    LoadStats run(uint32_t durationMs, uint8_t acquisitionThreads = 1,
+                  uint32_t batchIntervalMs = DeviceConfig::DEFAULT_SAMPLING_RATE_MS);
+    
+    /**
+     * @brief Stop a running test from another thread
+     */
+    void stop();
+    
+    /**
+     * @brief Get the sensors of the fleet
+     * 
+     * @return Sensors
+     */
+    const std::vector<std::shared_ptr<Sensors::SensorBase>>& getSensors() const;
+    
+    /**
+     * @brief Serialize statistics as JSON
+     * 
+     * @param stats Statistics
+     * @return JSON object
+     */
+    static std::string statsToJson(const LoadStats& stats);
+
+private:
+    std::shared_ptr<Data::DataProcessor> mProcessor;
+    std::shared_ptr<Communication::CommManager> mComm;
+    std::vector<std::shared_ptr<Sensors::SensorBase>> mSensors;
+    std::shared_ptr<LatencyTracer> mTracer;
+    std::atomic<bool> mRunning;
+};
+
+} // namespace System
+
+#endif // LOAD_HARNESS_H
@@ -0,0 +1,456 @@
+/**
+ * @file logger.h
+ * @brief Asynchronous low-overhead logging
+ * 
+ * This file provides the firmware logger. Call sites copy a fixed-size
+ * binary record (format string pointer plus packed arguments) into a
+ * per-thread lock-free ring; a background thread formats the records
+ * and writes them to the serial console and to LOG_FILE_PATH with
+ * size-based rotation. Levels below CURRENT_LOG_LEVEL compile to nothing.
+ * 
+ * Format strings must be string literals and use "{}" placeholders:
+ * 
+ *   LOG_INFO("sensor {} read {} values", id, count);
+ * 
+ * Per-reading paths use LOG_EVERY_N so a failing sensor or link cannot
+ * flood the rings.
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../config.h"
+
+namespace System {
+
+using DeviceConfig::LogLevel;
+
+/**
+ * @brief Check at compile time if a level is enabled
+ * 
+ * @param level Log level
+ * @return true if level is at or above CURRENT_LOG_LEVEL
+ */
+constexpr bool isLogLevelEnabled(LogLevel level) {
+    return static_cast<int>(level) >= static_cast<int>(DeviceConfig::CURRENT_LOG_LEVEL);
+}
+
+/**
+ * @brief Argument type tags stored in log records
+ */
+enum class LogArgType : uint8_t {
+    INT64,
+    UINT64,
+    DOUBLE,
+    BOOL,
+    CHAR,     ///< Formatted as the character, not its code
+    STRING,   ///< Length-prefixed bytes copied into the record
+    POINTER
+};
+
+/**
+ * @brief Binary log record
+ * 
+ * Fixed size so the ring is a flat array; arguments that do not fit
+ * are dropped and the record is marked truncated.
+ */
+struct LogRecord {
+    static constexpr size_t MAX_ARGS = 8;
+    static constexpr size_t PAYLOAD_SIZE = 128;
+    
+    uint64_t timestampNs;               ///< Wall clock time in nanoseconds
+    const char* format;                 ///< Format string literal
+    const char* file;                   ///< Source file
+    uint16_t line;                      ///< Source line
+    LogLevel level;                     ///< Log level
+    uint8_t argCount;                   ///< Number of encoded arguments
+    bool truncated;                     ///< Whether arguments were dropped
+    LogArgType argTypes[MAX_ARGS];      ///< Argument type tags
+    uint16_t payloadLength;             ///< Bytes used in payload
+    uint8_t payload[PAYLOAD_SIZE];      ///< Packed argument values
+};
+
+/**
+ * @brief Single-producer/single-consumer ring of log records
+ * 
+ * Each logging thread owns one ring; only the logger thread consumes.
+ */
+class LogRing {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param capacity Number of records, rounded up to a power of two
+     */
+    explicit LogRing(size_t capacity)
+        : mCapacity(roundUpPowerOfTwo(capacity)),
+          mMask(mCapacity - 1),
+          mRecords(new LogRecord[mCapacity]),
+          mHead(0),
+          mTail(0),
+          mDropped(0),
+          mAbandoned(false) {}
+    
+    /**
+     * @brief Reserve the next record slot
+     * 
+     * @return Slot to fill, or nullptr if the ring is full
+     */
+    LogRecord* reserve() {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) >= mCapacity) {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &mRecords[head & mMask];
+    }
+    
+    /**
+     * @brief Publish the slot returned by reserve()
+     */
+    void commit() {
+        mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Get the oldest unconsumed record
+     * 
+     * @return Record, or nullptr if the ring is empty
+     */
+    const LogRecord* front() const {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail == mHead.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &mRecords[tail & mMask];
+    }
+    
+    /**
+     * @brief Release the record returned by front()
+     */
+    void pop() {
+        mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Get and reset the number of records dropped because the ring was full
+     * 
+     * @return Dropped record count
+     */
+    uint64_t takeDropped() { return mDropped.exchange(0, std::memory_order_relaxed); }
+    
+    /**
+     * @brief Mark the ring as belonging to an exited thread
+     */
+    void abandon() { mAbandoned.store(true, std::memory_order_release); }
+    
+    /**
+     * @brief Check if the owning thread has exited
+     * 
+     * @return true if abandoned, false otherwise
+     */
+    bool isAbandoned() const { return mAbandoned.load(std::memory_order_acquire); }
+
+private:
+    static size_t roundUpPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    const size_t mCapacity;
+    const size_t mMask;
+    std::unique_ptr<LogRecord[]> mRecords;
+    alignas(64) std::atomic<size_t> mHead;
+    alignas(64) std::atomic<size_t> mTail;
+    std::atomic<uint64_t> mDropped;
+    std::atomic<bool> mAbandoned;
+};
+
+/**
+ * @brief Logger class
+ */
+class Logger {
+public:
+    /**
+     * @brief Get the process-wide logger
+     * 
+     * @return Logger instance
+     */
+    static Logger& instance();
+    
+    /**
+     * @brief Start the background writer thread
+     * 
+     * Opens LOG_FILE_PATH when LOG_TO_FILE is set.
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool start();
+    
+    /**
+     * @brief Drain all rings and stop the writer thread
+     */
+    void stop();
+    
+    /**
+     * @brief Block until every record committed so far has been written
+     */
+    void flush();
+    
+    /**
+     * @brief Record a log message
+     * 
+     * Never blocks, allocates or formats; if the calling thread's ring
+     * is full the record is dropped and counted.
+     * 
+     * @param level Log level
+     * @param file Source file
+     * @param line Source line
+     * @param format Format string literal with "{}" placeholders
+     * @param args Arguments
+     */
+    template <typename... Args>
+    void log(LogLevel level, const char* file, int line, const char* format, const Args&... args) {
+        if (static_cast<int>(level) < mLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+        LogRing& ring = threadRing();
+        LogRecord* record = ring.reserve();
+        if (record == nullptr) {
+            return;
+        }
+        record->timestampNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        record->format = format;
+        record->file = file;
+        record->line = static_cast<uint16_t>(line);
+        record->level = level;
+        record->argCount = 0;
+        record->truncated = false;
+        record->payloadLength = 0;
+        (void)std::initializer_list<int>{(encodeArg(*record, args), 0)...};
+        ring.commit();
+    }
+    
+    /**
+     * @brief Raise or lower the runtime log level
+     * 
+     * Levels below CURRENT_LOG_LEVEL stay compiled out whatever is set here.
+     * 
+     * @param level Lowest level recorded
+     */
+    void setLevel(LogLevel level) {
+        mLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Get the total number of dropped records
+     * 
+     * @return Dropped record count
+     */
+    uint64_t getDroppedCount() const;
+
+private:
+    std::vector<std::shared_ptr<LogRing>> mRings;
+    std::mutex mRingsMutex;
+    std::thread mWriter;
+    std::atomic<bool> mRunning;
+    std::atomic<uint64_t> mDropped;
+    std::atomic<int> mLevel;   ///< Runtime level, CURRENT_LOG_LEVEL until setLevel()
+    int mFileDescriptor;
+    uint32_t mFileSize;
+    
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+    
+    /**
+     * @brief Get the calling thread's ring, registering it on first use
+     * 
+     * @return Ring of the calling thread
+     */
+    LogRing& threadRing() {
+        struct Holder {
+            std::shared_ptr<LogRing> ring;
+            ~Holder() {
+                if (ring) {
+                    ring->abandon();
+                }
+            }
+        };
+        thread_local Holder holder;
+        if (!holder.ring) {
+            holder.ring = registerRing();
+        }
+        return *holder.ring;
+    }
+    
+    /**
+     * @brief Create and register a ring for the calling thread
+     * 
+     * @return New ring
+     */
+    std::shared_ptr<LogRing> registerRing();
+    
+    /**
+     * @brief Append raw bytes to the record payload
+     * 
+     * @param record Record being filled
+     * @param type Argument type tag
+     * @param data Bytes to append
+     * @param length Number of bytes
+     */
+    static void appendArg(LogRecord& record, LogArgType type, const void* data, size_t length) {
+        if (record.argCount >= LogRecord::MAX_ARGS ||
+            record.payloadLength + length > LogRecord::PAYLOAD_SIZE) {
+            record.truncated = true;
+            return;
+        }
+        std::memcpy(record.payload + record.payloadLength, data, length);
+        record.payloadLength = static_cast<uint16_t>(record.payloadLength + length);
+        record.argTypes[record.argCount++] = type;
+    }
+    
+    /**
+     * @brief Append a length-prefixed string, truncating it to the space left
+     * 
+     * @param record Record being filled
+     * @param data String bytes
+     * @param length String length
+     */
+    static void encodeString(LogRecord& record, const char* data, size_t length) {
+        size_t available = LogRecord::PAYLOAD_SIZE - record.payloadLength;
+        if (record.argCount >= LogRecord::MAX_ARGS || available <= sizeof(uint16_t)) {
+            record.truncated = true;
+            return;
+        }
+        if (length > available - sizeof(uint16_t)) {
+            length = available - sizeof(uint16_t);
+            record.truncated = true;
+        }
+        uint16_t length16 = static_cast<uint16_t>(length);
+        std::memcpy(record.payload + record.payloadLength, &length16, sizeof(length16));
+        std::memcpy(record.payload + record.payloadLength + sizeof(length16), data, length);
+        record.payloadLength = static_cast<uint16_t>(record.payloadLength + sizeof(length16) + length);
+        record.argTypes[record.argCount++] = LogArgType::STRING;
+    }
+    
+    /**
+     * @brief Encode one argument according to its type
+     * 
+     * @param record Record being filled
+     * @param value Argument value
+     */
+    template <typename T>
+    static void encodeArg(LogRecord& record, const T& value) {
+        if constexpr (std::is_same<T, bool>::value) {
+            uint8_t v = value ? 1 : 0;
+            appendArg(record, LogArgType::BOOL, &v, sizeof(v));
+        } else if constexpr (std::is_same<T, char>::value) {
+            appendArg(record, LogArgType::CHAR, &value, sizeof(value));
+        } else if constexpr (std::is_same<T, const char*>::value || std::is_same<T, char*>::value) {
+            if (value == nullptr) {
+                encodeString(record, "(null)", 6);
+            } else {
+                encodeString(record, value, std::strlen(value));
+            }
+        } else if constexpr (std::is_enum<T>::value) {
+            int64_t v = static_cast<int64_t>(value);
+            appendArg(record, LogArgType::INT64, &v, sizeof(v));
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            int64_t v = value;
+            appendArg(record, LogArgType::INT64, &v, sizeof(v));
+        } else if constexpr (std::is_integral<T>::value) {
+            uint64_t v = value;
+            appendArg(record, LogArgType::UINT64, &v, sizeof(v));
+        } else if constexpr (std::is_floating_point<T>::value) {
+            double v = value;
+            appendArg(record, LogArgType::DOUBLE, &v, sizeof(v));
+        } else if constexpr (std::is_convertible<T, std::string_view>::value) {
+            std::string_view v(value);
+            encodeString(record, v.data(), v.size());
+        } else {
+            static_assert(std::is_pointer<T>::value, "unsupported log argument type");
+            const void* v = value;
+            appendArg(record, LogArgType::POINTER, &v, sizeof(v));
+        }
+    }
+    
+    /**
+     * @brief Writer thread loop
+     */
+    void writerLoop();
+    
+    /**
+     * @brief Format a record into a line
+     * 
+     * @param record Record to format
+     * @param buffer Output buffer
+     * @param capacity Buffer capacity
+     * @return Bytes written
+     */
+    size_t formatRecord(const LogRecord& record, char* buffer, size_t capacity) const;
+    
+    /**
+     * @brief Write formatted bytes to the enabled sinks
+     * 
+     * Rotates the file to LOG_FILE_PATH.1 .. .N once it would exceed
+     * MAX_LOG_FILE_SIZE_KB.
+     * 
+     * @param data Formatted bytes
+     * @param length Number of bytes
+     */
+    void writeOut(const char* data, size_t length);
+    
+    /**
+     * @brief Rotate the log file
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool rotate();
+};
+
+} // namespace System
+
+#define LOG_AT_LEVEL(level, ...)                                                        \
+    do {                                                                                \
+        if constexpr (::System::isLogLevelEnabled(level)) {                             \
+            ::System::Logger::instance().log(level, __FILE__, __LINE__, __VA_ARGS__);   \
+        }                                                                               \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT_LEVEL(::DeviceConfig::LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT_LEVEL(::DeviceConfig::LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT_LEVEL(::DeviceConfig::LogLevel::WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT_LEVEL(::DeviceConfig::LogLevel::ERROR, __VA_ARGS__)
+#define LOG_CRITICAL(...) LOG_AT_LEVEL(::DeviceConfig::LogLevel::CRITICAL, __VA_ARGS__)
+
+// Logs the first and then every n-th execution of the call site, per thread; n <= 1 logs every time
+#define LOG_EVERY_N(level, n, ...)                                                      \
+    do {                                                                                \
+        if constexpr (::System::isLogLevelEnabled(level)) {                             \
+            thread_local uint32_t logEveryNCount = 0;                                   \
+            if ((n) <= 1 || logEveryNCount++ % (n) == 0) {                              \
+                ::System::Logger::instance().log(level, __FILE__, __LINE__, __VA_ARGS__); \
+            }                                                                           \
+        }                                                                               \
+    } while (0)
+
+#endif // LOGGER_H
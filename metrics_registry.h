@@ -0,0 +1,393 @@
+/**
+ * @file metrics_registry.h
+ * @brief Local metrics registry and OpenMetrics endpoint
+ * 
+ * This file provides counters, gauges and histograms that are cheap to
+ * update from any thread, and a small server that renders them in the
+ * OpenMetrics text format on an HTTP port and/or a Unix socket so
+ * nodes can be scraped without consuming uplink bandwidth. The HTTP
+ * listener binds to loopback by default; a LAN scraper needs
+ * METRICS_BIND_ADDRESS set to the LAN interface explicitly.
+ * 
+ * Counter and histogram updates go to a per-thread shard with a relaxed
+ * atomic add on a cache line only the calling thread writes; shards are
+ * summed when the endpoint is scraped.
+ */
+
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../system/error_handler.h"
+
+namespace System {
+
+/**
+ * @brief Metric families supported by the registry
+ */
+enum class MetricType : uint8_t {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+};
+
+/**
+ * @brief Per-thread counter storage
+ * 
+ * Slot 0 is a sink that default-constructed handles write to, so
+ * updating an unregistered metric is harmless and needs no branch.
+ */
+struct alignas(64) MetricShard {
+    std::atomic<uint64_t> slots[DeviceConfig::METRICS_MAX_SLOTS];
+    
+    MetricShard() {
+        for (auto& slot : slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+class MetricsRegistry;
+
+/**
+ * @brief Monotonic counter handle
+ */
+class Counter {
+public:
+    Counter() : mSlot(0) {}
+    
+    /**
+     * @brief Increment the counter
+     * 
+     * @param value Amount to add
+     */
+    inline void inc(uint64_t value = 1) const;
+
+private:
+    friend class MetricsRegistry;
+    explicit Counter(uint16_t slot) : mSlot(slot) {}
+    uint16_t mSlot;
+};
+
+/**
+ * @brief Gauge handle
+ * 
+ * Gauges hold a current value rather than an accumulation, so they are
+ * stored once in the registry instead of per thread.
+ */
+class Gauge {
+public:
+    Gauge() : mValue(nullptr) {}
+    
+    /**
+     * @brief Set the gauge
+     * 
+     * @param value New value
+     */
+    void set(double value) const {
+        if (mValue != nullptr) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            mValue->store(bits, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    friend class MetricsRegistry;
+    explicit Gauge(std::atomic<uint64_t>* value) : mValue(value) {}
+    std::atomic<uint64_t>* mValue;
+};
+
+/**
+ * @brief Histogram handle
+ * 
+ * Uses one slot per bucket plus one for the count and one for the sum.
+ * Bucket bounds are fixed at registration.
+ */
+class Histogram {
+public:
+    Histogram() : mSlot(0), mBounds(nullptr), mBucketCount(0) {}
+    
+    /**
+     * @brief Record an observation
+     * 
+     * NaN is ignored; the sum saturates instead of overflowing.
+     * 
+     * @param value Observed value, in the unit of the bucket bounds
+     */
+    inline void observe(double value) const;
+
+private:
+    friend class MetricsRegistry;
+    Histogram(uint16_t slot, const double* bounds, uint16_t bucketCount)
+        : mSlot(slot), mBounds(bounds), mBucketCount(bucketCount) {}
+    uint16_t mSlot;
+    const double* mBounds;
+    uint16_t mBucketCount;
+};
+
+/**
+ * @brief Metrics registry class
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief Get the process-wide registry
+     * 
+     * @return Registry instance
+     */
+    static MetricsRegistry& instance();
+    
+    /**
+     * @brief Register a counter
+     * 
+     * Registering the same name and labels twice returns the same handle.
+     * 
+     * @param name Metric name, without the "_total" suffix
+     * @param help Help text
+     * @param labels Label set, e.g. "sensor=\"3\"", may be empty
+     * @return Counter handle, the sink handle if the registry is full
+     */
+    Counter registerCounter(const std::string& name, const std::string& help,
+                            const std::string& labels = "");
+    
+    /**
+     * @brief Register a gauge
+     * 
+     * @param name Metric name
+     * @param help Help text
+     * @param labels Label set, may be empty
+     * @return Gauge handle, the sink handle if the registry is full
+     */
+    Gauge registerGauge(const std::string& name, const std::string& help,
+                        const std::string& labels = "");
+    
+    /**
+     * @brief Register a histogram
+     * 
+     * @param name Metric name
+     * @param help Help text
+     * @param bounds Ascending upper bucket bounds, +Inf is implicit
+     * @param labels Label set, may be empty
+     * @return Histogram handle, the sink handle if the registry is full
+     */
+    Histogram registerHistogram(const std::string& name, const std::string& help,
+                                const std::vector<double>& bounds,
+                                const std::string& labels = "");
+    
+    /**
+     * @brief Render all metrics in the OpenMetrics text format
+     * 
+     * Sums the per-thread shards; safe to call concurrently with updates.
+     * 
+     * @param output String to append to, terminated by "# EOF"
+     */
+    void render(std::string& output) const;
+    
+    /**
+     * @brief Get the calling thread's shard, registering it on first use
+     * 
+     * The shard is retired when the thread exits.
+     * 
+     * @return Shard of the calling thread
+     */
+    MetricShard& threadShard() {
+        thread_local ThreadShard holder;
+        if (!holder.shard) {
+            holder.shard = registerShard();
+        }
+        return *holder.shard;
+    }
+
+private:
+    /**
+     * @brief Thread-local owner of a shard that retires it on thread exit
+     */
+    struct ThreadShard {
+        std::shared_ptr<MetricShard> shard;
+        
+        ~ThreadShard() {
+            if (shard) {
+                MetricsRegistry::instance().retireShard(shard);
+            }
+        }
+    };
+    
+    struct MetricFamily {
+        std::string name;
+        std::string help;
+        std::string labels;
+        MetricType type;
+        uint16_t slot;                   ///< First shard slot (counters, histograms)
+        std::vector<double> bounds;      ///< Histogram bucket bounds
+        std::unique_ptr<std::atomic<uint64_t>> gauge;  ///< Gauge value bits
+    };
+    
+    std::vector<std::unique_ptr<MetricFamily>> mFamilies;
+    std::vector<std::shared_ptr<MetricShard>> mShards;  ///< Shards of live threads
+    std::unique_ptr<MetricShard> mRetired;  ///< Sums of exited threads' shards, keeps counters monotonic
+    uint16_t mNextSlot;
+    mutable std::mutex mMutex;
+    
+    MetricsRegistry();
+    ~MetricsRegistry();
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    
+    /**
+     * @brief Create and register a shard for the calling thread
+     * 
+     * @return New shard
+     */
+    std::shared_ptr<MetricShard> registerShard();
+    
+    /**
+     * @brief Fold an exiting thread's shard into mRetired and free it
+     * 
+     * @param shard Shard of the exiting thread
+     */
+    void retireShard(const std::shared_ptr<MetricShard>& shard);
+    
+    /**
+     * @brief Find a family by name and labels
+     * 
+     * @param name Metric name
+     * @param labels Label set
+     * @return Family, or nullptr if not registered
+     */
+    MetricFamily* find(const std::string& name, const std::string& labels);
+    
+    /**
+     * @brief Reserve consecutive shard slots
+     * 
+     * @param count Number of slots
+     * @return First slot, 0 if the registry is full
+     */
+    uint16_t allocateSlots(uint16_t count);
+    
+    /**
+     * @brief Sum one slot over all shards
+     * 
+     * Includes mRetired.
+     * 
+     * @param slot Slot index
+     * @return Sum
+     */
+    uint64_t sumSlot(uint16_t slot) const;
+};
+
+inline void Counter::inc(uint64_t value) const {
+    MetricsRegistry::instance().threadShard().slots[mSlot].fetch_add(value, std::memory_order_relaxed);
+}
+
+inline void Histogram::observe(double value) const {
+    if (mSlot == 0 || std::isnan(value)) {
+        return;
+    }
+    MetricShard& shard = MetricsRegistry::instance().threadShard();
+    uint16_t bucket = 0;
+    while (bucket < mBucketCount && value > mBounds[bucket]) {
+        ++bucket;
+    }
+    // Layout: buckets [0, count], +Inf bucket, observation count, sum (fixed point, 1e-6)
+    shard.slots[mSlot + bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.slots[mSlot + mBucketCount + 1].fetch_add(1, std::memory_order_relaxed);
+    double sum = value > 0.0 ? std::min(value * 1e6, 1.8e19) : 0.0;
+    shard.slots[mSlot + mBucketCount + 2].fetch_add(static_cast<uint64_t>(sum), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Metrics endpoint class
+ * 
+ * Serves "GET /metrics" with the registry contents. Connections are
+ * handled one at a time on a single thread; a scrape costs one render.
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param registry Registry to serve
+     */
+    explicit MetricsServer(MetricsRegistry& registry = MetricsRegistry::instance());
+    
+    /**
+     * @brief Destructor, stops the server
+     */
+    ~MetricsServer();
+    
+    /**
+     * @brief Start serving
+     * 
+     * @param bindAddress Address for the HTTP listener, empty to disable it
+     * @param port HTTP port
+     * @param unixSocketPath Unix socket path, empty to disable it
+     * @return true if at least one listener is up, false otherwise
+     */
+    bool start(
+        const std::string& bindAddress = DeviceConfig::METRICS_BIND_ADDRESS,
+        uint16_t port = DeviceConfig::METRICS_HTTP_PORT,
+        const std::string& unixSocketPath = DeviceConfig::METRICS_UNIX_SOCKET
+    );
+    
+    /**
+     * @brief Stop serving and close the listeners
+     */
+    void stop();
+    
+    /**
+     * @brief Check if the server is running
+     * 
+     * @return true if running, false otherwise
+     */
+    bool isRunning() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    ErrorCode getLastError() const;
+
+private:
+    MetricsRegistry& mRegistry;
+    int mTcpSocket;
+    int mUnixSocket;
+    std::string mUnixSocketPath;
+    std::thread mThread;
+    std::atomic<bool> mRunning;
+    ErrorCode mLastError;
+    
+    /**
+     * @brief Accept and answer requests until stopped
+     */
+    void serveLoop();
+    
+    /**
+     * @brief Answer one request on an accepted connection
+     * 
+     * @param fd Connection descriptor
+     */
+    void handleConnection(int fd);
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(ErrorCode error);
+};
+
+} // namespace System
+
+#endif // METRICS_REGISTRY_H
@@ -10,10 +10,16 @@
 #define MQTT_CLIENT_H
 
 #include <string>
+#include <string_view>
 #include <functional>
 #include <vector>
+#include <deque>
 #include <mutex>
+#include <memory>
 #include "../system/error_handler.h"
+#include "../system/metrics_registry.h"
+#include "tls_context.h"
+#include "buffer_chain.h"
 
 // Forward declaration for the MQTT client implementation
 // In a real implementation, this would be a concrete type
@@ -48,6 +54,21 @@ enum class MQTTConnectionState {
  */
 using MQTTMessageCallback = std::function<void(const std::string&, const std::string&)>;
 
+/**
+ * @brief MQTT message callback type with views into the receive buffer
+ * 
+ * The views are only valid for the duration of the call.
+ */
+using MQTTMessageViewCallback = std::function<void(std::string_view, std::string_view)>;
+
+/**
+ * @brief MQTT delivery callback type
+ * 
+ * Called with the packet identifier once the broker has acknowledged
+ * a QoS 1 (PUBACK) or QoS 2 (PUBCOMP) publish.
+ */
+using MQTTDeliveryCallback = std::function<void(uint16_t)>;
+
 /**
  * @brief MQTT client class
  */
@@ -107,13 +128,42 @@ public:
      * @param payload Message payload
      * @param qos Quality of Service level
      * @param retain Whether the message should be retained
+     * @param messageId Optional pointer to store the packet identifier
      * @return true if publish successful, false otherwise
      */
     bool publish(
         const std::string& topic,
         const std::string& payload,
         MQTTQoS qos = MQTTQoS::AT_LEAST_ONCE,
-        bool retain = false
+        bool retain = false,
+        uint16_t* messageId = nullptr
+    );
+    
+    /**
+     * @brief Publish a buffer chain without coalescing it
+     * 
+     * The MQTT fixed and variable headers are built on the stack and
+     * written together with the chain segments in one writev/sendmsg, or
+     * in IOV_MAX-sized batches for longer chains. Payloads of at least
+     * MQTT_ZEROCOPY_THRESHOLD bytes on plain TCP use MSG_ZEROCOPY; a share() of the chain is parked in
+     * mZeroCopyPending until the kernel reports completion on the socket
+     * error queue, so the segments are not reused while the NIC may still
+     * read them. Over TLS the segments are passed to
+     * the TLS library record by record.
+     * 
+     * @param topic Topic to publish to
+     * @param payload Payload chain
+     * @param qos Quality of Service level
+     * @param retain Whether the message should be retained
+     * @param messageId Optional pointer to store the packet identifier
+     * @return true if publish successful, false otherwise
+     */
+    bool publish(
+        const std::string& topic,
+        const BufferChain& payload,
+        MQTTQoS qos = MQTTQoS::AT_LEAST_ONCE,
+        bool retain = false,
+        uint16_t* messageId = nullptr
     );
     
     /**
@@ -143,6 +193,22 @@ public:
      */
     void setMessageCallback(MQTTMessageCallback callback);
     
+    /**
+     * @brief Set callback for message reception without copying
+     * 
+     * Takes precedence over the callback set with setMessageCallback().
+     * 
+     * @param callback Function to call with views into the receive buffer
+     */
+    void setMessageViewCallback(MQTTMessageViewCallback callback);
+    
+    /**
+     * @brief Set callback for delivery acknowledgements
+     * 
+     * @param callback Function to call when a publish is acknowledged
+     */
+    void setDeliveryCallback(MQTTDeliveryCallback callback);
+    
     /**
      * @brief Check if client is connected
      * 
@@ -177,6 +243,18 @@ public:
         const std::string& clientCert = "",
         const std::string& privateKey = ""
     );
+    
+    /**
+     * @brief Use a shared TLS context instead of per-client certificate files
+     * 
+     * The context keeps parsed certificates in memory and caches session
+     * tickets, so reconnects resume the previous session when the broker
+     * allows it. Takes precedence over setTLSCertificates().
+     * 
+     * @param context Shared TLS context
+     * @return true if successful, false otherwise
+     */
+    bool setTLSContext(std::shared_ptr<TLSContext> context);
 
 private:
     std::string mClientId;
@@ -189,18 +267,63 @@ private:
     MQTTConnectionState mConnectionState;
     System::ErrorCode mLastError;
     MQTTMessageCallback mMessageCallback;
+    MQTTMessageViewCallback mMessageViewCallback;
+    MQTTDeliveryCallback mDeliveryCallback;
     std::string mCaCert;
     std::string mClientCert;
     std::string mPrivateKey;
+    std::shared_ptr<TLSContext> mTlsContext;
     std::mutex mMutex;
+    System::Counter mPublishedMetric;      ///< mqtt_published_total{client="<id>"}
+    System::Counter mPublishFailedMetric;  ///< mqtt_publish_failed_total{client="<id>"}
+    System::Counter mPublishedBytesMetric; ///< mqtt_published_bytes_total{client="<id>"}
+    System::Counter mReceivedMetric;       ///< mqtt_received_total{client="<id>"}
+    System::Counter mReconnectsMetric;     ///< mqtt_reconnects_total{client="<id>"}
+    System::Gauge mConnectedMetric;        ///< mqtt_connected{client="<id>"}
+    
+    /**
+     * @brief Chain held until its MSG_ZEROCOPY send completes
+     */
+    struct ZeroCopySend {
+        uint32_t sequence;  ///< Per-socket zerocopy counter value of the send
+        BufferChain chain;  ///< Shared reference to the sent segments
+    };
+    
+    std::deque<ZeroCopySend> mZeroCopyPending; ///< In send order, guarded by mMutex
+    uint32_t mZeroCopySequence;                ///< Counter value of the next MSG_ZEROCOPY send
+    
+    /**
+     * @brief Drain MSG_ZEROCOPY completions from the socket error queue
+     * 
+     * Reads SO_EE_ORIGIN_ZEROCOPY notifications with MSG_ERRQUEUE and
+     * releases every pending chain whose sequence lies in a reported
+     * [ee_info, ee_data] range. Called from the network loop whenever
+     * the socket polls POLLERR.
+     */
+    void processZeroCopyCompletions();
+    
+    /**
+     * @brief Release all chains held for MSG_ZEROCOPY
+     * 
+     * Called once the socket is closed, after which the kernel no longer
+     * references the pages.
+     */
+    void releaseZeroCopyPending();
     
     /**
      * @brief Process incoming messages
      * 
-     * @param topic Message topic
-     * @param payload Message payload
+     * @param topic Message topic, a view into the receive buffer
+     * @param payload Message payload, a view into the receive buffer
+     */
+    void onMessageReceived(std::string_view topic, std::string_view payload);
+    
+    /**
+     * @brief Process delivery acknowledgements
+     * 
+     * @param messageId Packet identifier of the acknowledged publish
      */
-    void onMessageReceived(const std::string& topic, const std::string& payload);
+    void onDeliveryComplete(uint16_t messageId);
     
     /**
      * @brief Handle connection state changes
@@ -0,0 +1,342 @@
+/**
+ * @file mqtt_connection_pool.h
+ * @brief Pool of MQTT connections across one or more brokers
+ * 
+ * This file provides a pool that shards topics over several MQTT
+ * connections, mirrors telemetry to secondary brokers, fails over when
+ * connections drop and publishes from one thread per connection.
+ */
+
+#ifndef MQTT_CONNECTION_POOL_H
+#define MQTT_CONNECTION_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../system/error_handler.h"
+#include "../system/bounded_queue.h"
+#include "mqtt_client.h"
+#include "tls_context.h"
+#include "buffer_chain.h"
+
+namespace Communication {
+
+/**
+ * @brief Role of a broker in the pool
+ */
+enum class BrokerRole {
+    PRIMARY,  ///< Receives all traffic; topics are sharded over its connections
+    MIRROR,   ///< Receives a copy of telemetry topics only
+    STANDBY   ///< Used only while every PRIMARY connection is down
+};
+
+/**
+ * @brief Broker endpoint description
+ */
+struct BrokerEndpoint {
+    std::string name;         ///< Name used in logs and statistics
+    std::string host;         ///< Broker address
+    uint16_t port;            ///< Broker port
+    std::string username;     ///< Username for authentication (optional)
+    std::string password;     ///< Password for authentication (optional)
+    bool useTls;              ///< Whether to use TLS
+    BrokerRole role;          ///< Role of the broker
+    uint8_t connections;      ///< Number of parallel connections to open
+    
+    BrokerEndpoint()
+        : name(), host(), port(DeviceConfig::MQTT_PORT), username(), password(),
+          useTls(DeviceConfig::ENABLE_TLS), role(BrokerRole::PRIMARY),
+          connections(DeviceConfig::MQTT_CONNECTIONS_PER_BROKER) {}
+};
+
+/**
+ * @brief Per-connection statistics
+ */
+struct ConnectionStats {
+    std::string broker;        ///< Broker name
+    uint8_t index;             ///< Connection index within the broker
+    MQTTConnectionState state; ///< Current connection state
+    uint64_t published;        ///< Messages published
+    uint64_t failed;           ///< Publishes that failed
+    uint32_t reconnects;       ///< Reconnections performed
+    size_t queueDepth;         ///< Messages waiting for this connection
+};
+
+/**
+ * @brief Delivery callback type
+ * 
+ * Called exactly once per delivery ID returned by publish(): with true
+ * once the broker acknowledged the message (or, for QoS 0, once it was
+ * written), with false if it was dropped from the queue or lost with
+ * its connection.
+ */
+using PoolDeliveryCallback = std::function<void(uint32_t, bool)>;
+
+/**
+ * @brief Socket write callback type
+ * 
+ * Called on the publisher thread with the delivery ID once
+ * MQTTClient::publish() has handed the message to the socket.
+ */
+using PoolWriteCallback = std::function<void(uint32_t)>;
+
+/**
+ * @brief MQTT connection pool class
+ * 
+ * Topics are assigned to connections by rendezvous hashing over the
+ * healthy connections of a broker, so a dropped connection only moves
+ * its own topics and per-topic ordering is kept while it is up.
+ */
+class MQTTConnectionPool {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param clientId Base client identifier; connections append "-<broker>-<n>"
+     */
+    explicit MQTTConnectionPool(const std::string& clientId);
+    
+    /**
+     * @brief Destructor, stops publisher threads
+     */
+    ~MQTTConnectionPool();
+    
+    /**
+     * @brief Add a broker to the pool
+     * 
+     * Must be called before initialize().
+     * 
+     * @param endpoint Broker endpoint
+     * @return true if added, false otherwise
+     */
+    bool addBroker(const BrokerEndpoint& endpoint);
+    
+    /**
+     * @brief Create clients for all brokers
+     * 
+     * @param tlsContext Shared TLS context used by TLS connections (may be null)
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize(std::shared_ptr<TLSContext> tlsContext);
+    
+    /**
+     * @brief Connect all clients and start publisher threads
+     * 
+     * @return true if at least one PRIMARY or STANDBY connection is up
+     */
+    bool connect();
+    
+    /**
+     * @brief Disconnect all clients and stop publisher threads
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool disconnect();
+    
+    /**
+     * @brief Queue a message for publishing
+     * 
+     * The message goes to the connection owning the topic on the active
+     * primary broker and, if mirror is set, to every MIRROR broker.
+     * 
+     * @param topic Topic to publish to
+     * @param payload Message payload
+     * @param qos Quality of Service level
+     * @param mirror Whether to also send the message to MIRROR brokers
+     * @param deliveryId Optional pointer to store the delivery ID on the primary
+     * @return true if queued, false if no connection is available or the queue is full
+     */
+    bool publish(
+        const std::string& topic,
+        const std::string& payload,
+        MQTTQoS qos = MQTTQoS::AT_LEAST_ONCE,
+        bool mirror = false,
+        uint32_t* deliveryId = nullptr
+    );
+    
+    /**
+     * @brief Queue a buffer chain for publishing without copying
+     * 
+     * Mirrors receive shared references to the same segments.
+     * 
+     * @param topic Topic to publish to
+     * @param payload Payload chain
+     * @param qos Quality of Service level
+     * @param mirror Whether to also send the message to MIRROR brokers
+     * @param deliveryId Optional pointer to store the delivery ID on the primary
+     * @return true if queued, false if no connection is available or the queue is full
+     */
+    bool publish(
+        const std::string& topic,
+        BufferChain&& payload,
+        MQTTQoS qos = MQTTQoS::AT_LEAST_ONCE,
+        bool mirror = false,
+        uint32_t* deliveryId = nullptr
+    );
+    
+    /**
+     * @brief Subscribe to a topic on the active primary broker
+     * 
+     * Subscriptions are re-established automatically after failover.
+     * 
+     * @param topic Topic to subscribe to
+     * @param qos Quality of Service level
+     * @return true if successful, false otherwise
+     */
+    bool subscribe(const std::string& topic, MQTTQoS qos = MQTTQoS::AT_LEAST_ONCE);
+    
+    /**
+     * @brief Set callback for inbound messages from any connection
+     * 
+     * @param callback Function to call with views into the receive buffer
+     */
+    void setMessageViewCallback(MQTTMessageViewCallback callback);
+    
+    /**
+     * @brief Set callback for delivery acknowledgements
+     * 
+     * @param callback Function to call with the delivery ID
+     */
+    void setDeliveryCallback(PoolDeliveryCallback callback);
+    
+    /**
+     * @brief Set callback for completed socket writes
+     * 
+     * @param callback Function to call with the delivery ID
+     */
+    void setWriteCallback(PoolWriteCallback callback);
+    
+    /**
+     * @brief Check if any PRIMARY or STANDBY connection is up
+     * 
+     * @return true if connected, false otherwise
+     */
+    bool isConnected() const;
+    
+    /**
+     * @brief Get statistics for every connection
+     * 
+     * @return Vector of connection statistics
+     */
+    std::vector<ConnectionStats> getStats() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    /**
+     * @brief Message queued for a connection's publisher thread
+     */
+    struct PublishJob {
+        std::string topic;
+        BufferChain payload;
+        MQTTQoS qos;
+        uint32_t deliveryId;
+    };
+    
+    /**
+     * @brief A single connection and its publisher thread
+     */
+    struct Connection {
+        size_t brokerIndex;
+        uint8_t index;
+        std::unique_ptr<MQTTClient> client;
+        std::unique_ptr<System::BoundedQueue<PublishJob>> queue;
+        std::thread publisher;
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        std::atomic<uint64_t> published;
+        std::atomic<uint64_t> failed;
+        std::atomic<uint32_t> reconnects;
+        std::map<uint16_t, uint32_t> packetToDelivery; ///< MQTT packet ID to pool delivery ID
+        std::mutex packetMutex;                        ///< Guards packetToDelivery
+    };
+    
+    std::string mClientId;
+    std::vector<BrokerEndpoint> mBrokers;
+    std::vector<std::unique_ptr<Connection>> mConnections;
+    std::vector<std::pair<std::string, MQTTQoS>> mSubscriptions;
+    std::atomic<size_t> mActivePrimary;   ///< Broker index currently acting as primary
+    std::atomic<uint32_t> mNextDeliveryId;
+    std::atomic<bool> mRunning;
+    MQTTMessageViewCallback mMessageCallback;
+    PoolDeliveryCallback mDeliveryCallback;
+    PoolWriteCallback mWriteCallback;
+    System::ErrorCode mLastError;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Pick the connection owning a topic on a broker
+     * 
+     * @param brokerIndex Broker index
+     * @param topic Topic
+     * @return Connection, or nullptr if the broker has no healthy connection
+     */
+    Connection* selectConnection(size_t brokerIndex, const std::string& topic) const;
+    
+    /**
+     * @brief Handle a connection state change
+     * 
+     * Reconnects the dropped connection in the background and switches
+     * the active primary to a STANDBY broker when all PRIMARY connections
+     * are down, moving subscriptions along.
+     * 
+     * @param connection Connection whose state changed
+     * @param state New connection state
+     */
+    void onConnectionStateChanged(Connection& connection, MQTTConnectionState state);
+    
+    /**
+     * @brief Resolve a PUBACK to its delivery and report it
+     * 
+     * Called from the client's delivery callback; removes the packet ID
+     * from the connection's map.
+     * 
+     * @param connection Connection that received the ack
+     * @param messageId MQTT packet identifier
+     */
+    void onPacketAcknowledged(Connection& connection, uint16_t messageId);
+    
+    /**
+     * @brief Fail every delivery still waiting for an ack on a connection
+     * 
+     * Called when the connection drops, since packet IDs are not valid
+     * across sessions.
+     * 
+     * @param connection Connection that dropped
+     */
+    void failPendingDeliveries(Connection& connection);
+    
+    /**
+     * @brief Publisher thread loop
+     * 
+     * Holds packetMutex across each QoS 1/2 publish until its packet ID is
+     * in packetToDelivery, so an early PUBACK cannot miss the mapping.
+     * 
+     * @param connection Connection served by the thread
+     */
+    void publisherLoop(Connection& connection);
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Communication
+
+#endif // MQTT_CONNECTION_POOL_H
@@ -0,0 +1,258 @@
+/**
+ * @file payload_cipher.h
+ * @brief End-to-end AEAD payload encryption
+ * 
+ * This file provides an authenticated encryption layer for message
+ * payloads that operates in place on the serialization buffer, with
+ * counter-based nonce management and key rotation.
+ * 
+ * Sealed payload layout:
+ * 
+ *   | version (1) | algorithm (1) | keyId (4, BE) | nonce (12) | ciphertext (n) | tag (16) |
+ * 
+ * The algorithm byte carries the resolved AEADAlgorithm, never AUTO, so
+ * the receiver does not depend on which cipher the sender's CPU favours.
+ * 
+ * The nonce is the 32-bit boot epoch followed by a 64-bit message
+ * counter, so a nonce is never reused under the same key as long as
+ * the boot epoch is persisted and incremented on every start.
+ */
+
+#ifndef PAYLOAD_CIPHER_H
+#define PAYLOAD_CIPHER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "../config.h"
+#include "../system/error_handler.h"
+
+namespace Communication {
+
+/**
+ * @brief AEAD algorithms supported for payload encryption
+ * 
+ * The values of the concrete algorithms are their header ids.
+ */
+enum class AEADAlgorithm : uint8_t {
+    AUTO = 0,              ///< AES-128-GCM with hardware AES, ChaCha20-Poly1305 otherwise
+    AES_128_GCM = 1,       ///< AES-128 in Galois/Counter Mode
+    CHACHA20_POLY1305 = 2  ///< ChaCha20 stream cipher with Poly1305 MAC
+};
+
+/**
+ * @brief Payload key with its identifier
+ */
+struct PayloadKey {
+    uint32_t keyId;                     ///< Key identifier sent in the header
+    std::array<uint8_t, 32> material;   ///< Key material (first 16 bytes used for AES-128)
+    uint64_t messagesSealed;            ///< Number of messages sealed with this key
+    bool valid;                         ///< Whether the key slot is populated
+    
+    PayloadKey() : keyId(0), material(), messagesSealed(0), valid(false) {}
+};
+
+/**
+ * @brief Payload cipher class
+ * 
+ * Sealing never allocates: callers serialize into a buffer that
+ * reserves HEADER_SIZE bytes of headroom and TAG_SIZE bytes of
+ * tailroom, and the ciphertext overwrites the plaintext.
+ */
+class PayloadCipher {
+public:
+    static constexpr uint8_t FORMAT_VERSION = 2;
+    static constexpr size_t NONCE_SIZE = 12;
+    static constexpr size_t HEADER_SIZE = 1 + 1 + 4 + NONCE_SIZE;
+    static constexpr size_t TAG_SIZE = 16;
+    static constexpr size_t OVERHEAD = HEADER_SIZE + TAG_SIZE;
+    
+    /**
+     * @brief Incremental sealing state for chunked buffers
+     */
+    struct SealStream {
+        uint8_t header[HEADER_SIZE];  ///< Header to prepend to the ciphertext
+        uint8_t state[256];           ///< Opaque cipher and MAC state
+        uint64_t length;              ///< Number of bytes processed so far
+        bool active;                  ///< Whether a message is in progress
+        
+        SealStream() : header(), state(), length(0), active(false) {}
+    };
+    
+    /**
+     * @brief Constructor
+     * 
+     * @param algorithm AEAD algorithm to use
+     */
+    explicit PayloadCipher(AEADAlgorithm algorithm = AEADAlgorithm::AUTO);
+    
+    /**
+     * @brief Destructor, wipes key material
+     */
+    ~PayloadCipher();
+    
+    /**
+     * @brief Initialize the cipher
+     * 
+     * @param bootEpoch Persisted boot counter used as the nonce prefix
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize(uint32_t bootEpoch);
+    
+    /**
+     * @brief Install a new key and make it current
+     * 
+     * The previous key is kept so that messages sealed just before
+     * the rotation can still be opened during the grace period.
+     * 
+     * @param keyId Identifier of the new key
+     * @param key Key material
+     * @param length Key length in bytes, see isValidKeyLength()
+     * @return true if successful, false otherwise
+     */
+    bool rotateKey(uint32_t keyId, const uint8_t* key, size_t length);
+    
+    /**
+     * @brief Check if a key length is usable with an algorithm
+     * 
+     * AUTO may resolve to ChaCha20-Poly1305, which needs a 32-byte key,
+     * so 16-byte keys are only accepted when AES-128-GCM is pinned.
+     * 
+     * @param algorithm Configured algorithm
+     * @param length Key length in bytes
+     * @return true if the length is usable, false otherwise
+     */
+    static bool isValidKeyLength(AEADAlgorithm algorithm, size_t length) {
+        return length == 32 || (length == 16 && algorithm == AEADAlgorithm::AES_128_GCM);
+    }
+    
+    /**
+     * @brief Check if the current key should be rotated
+     * 
+     * @return true once PAYLOAD_KEY_ROTATION_MESSAGES messages were sealed
+     */
+    bool needsRotation() const;
+    
+    /**
+     * @brief Seal a message in place
+     * 
+     * On entry buffer[HEADER_SIZE, HEADER_SIZE + plaintextLength) holds the
+     * plaintext. On success buffer[0, sealedLength) holds the sealed payload.
+     * 
+     * @param buffer Buffer with headroom and tailroom reserved
+     * @param plaintextLength Length of the plaintext
+     * @param capacity Total capacity of the buffer
+     * @param sealedLength Reference to store the sealed payload length
+     * @param aad Additional authenticated data (e.g. the topic), may be null
+     * @param aadLength Length of the additional authenticated data
+     * @return true if successful, false otherwise
+     */
+    bool seal(uint8_t* buffer, size_t plaintextLength, size_t capacity, size_t& sealedLength,
+              const uint8_t* aad = nullptr, size_t aadLength = 0);
+    
+    /**
+     * @brief Open a sealed message in place
+     * 
+     * The message is opened with the algorithm named in its header, which
+     * may differ from the one this cipher seals with. Unknown versions and
+     * algorithm ids are rejected.
+     * 
+     * @param buffer Sealed payload, decrypted in place
+     * @param length Length of the sealed payload
+     * @param plaintextLength Reference to store the plaintext length;
+     *        the plaintext starts at buffer + HEADER_SIZE
+     * @param aad Additional authenticated data, may be null
+     * @param aadLength Length of the additional authenticated data
+     * @return true if the tag verified, false otherwise
+     */
+    bool open(uint8_t* buffer, size_t length, size_t& plaintextLength,
+              const uint8_t* aad = nullptr, size_t aadLength = 0);
+    
+    /**
+     * @brief Start sealing a message spread over several buffers
+     * 
+     * @param stream Stream state to initialize
+     * @param aad Additional authenticated data, may be null
+     * @param aadLength Length of the additional authenticated data
+     * @return true if successful, false otherwise
+     */
+    bool beginSeal(SealStream& stream, const uint8_t* aad = nullptr, size_t aadLength = 0);
+    
+    /**
+     * @brief Encrypt the next chunk of a message in place
+     * 
+     * @param stream Stream state
+     * @param data Chunk to encrypt
+     * @param length Chunk length
+     * @return true if successful, false otherwise
+     */
+    bool updateSeal(SealStream& stream, uint8_t* data, size_t length);
+    
+    /**
+     * @brief Finish a streamed message and produce the tag
+     * 
+     * @param stream Stream state
+     * @param tag Buffer of TAG_SIZE bytes to store the tag
+     * @return true if successful, false otherwise
+     */
+    bool finishSeal(SealStream& stream, uint8_t* tag);
+    
+    /**
+     * @brief Get the resolved algorithm
+     * 
+     * @return Algorithm in use
+     */
+    AEADAlgorithm getAlgorithm() const;
+    
+    /**
+     * @brief Get the current key identifier
+     * 
+     * @return Current key identifier
+     */
+    uint32_t getCurrentKeyId() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    AEADAlgorithm mAlgorithm;
+    PayloadKey mCurrentKey;
+    PayloadKey mPreviousKey;
+    uint32_t mBootEpoch;
+    uint64_t mNonceCounter;
+    bool mInitialized;
+    System::ErrorCode mLastError;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Produce the next nonce for the current key
+     * 
+     * @param nonce Buffer of NONCE_SIZE bytes
+     * @return false if the counter space is exhausted
+     */
+    bool nextNonce(uint8_t* nonce);
+    
+    /**
+     * @brief Find a key by identifier
+     * 
+     * @param keyId Key identifier
+     * @return Pointer to the key, or nullptr if unknown
+     */
+    const PayloadKey* findKey(uint32_t keyId) const;
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Communication
+
+#endif // PAYLOAD_CIPHER_H
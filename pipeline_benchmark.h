@@ -0,0 +1,224 @@
+/**
+ * @file pipeline_benchmark.h
+ * @brief On-device micro-benchmarks for the data pipeline
+ * 
+ * This file provides a small benchmark runner that times filters,
+ * DataProcessor operations and serialization over a grid of sensor
+ * counts, channel counts and window sizes, and reports nanoseconds,
+ * heap allocations and output bytes per reading. It runs on the target
+ * hardware, so results can be used both to catch regressions against a
+ * stored baseline and to size hardware.
+ */
+
+#ifndef PIPELINE_BENCHMARK_H
+#define PIPELINE_BENCHMARK_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+
+namespace System {
+
+/**
+ * @brief Heap allocation counter
+ * 
+ * Counts calls to the global operator new on the calling thread. The
+ * counting operator new is defined in pipeline_benchmark.cpp, which is
+ * only linked into the benchmark binary, so counting is always on there
+ * and the firmware keeps the default allocator.
+ */
+class AllocationCounter {
+public:
+    /**
+     * @brief Get the number of allocations made by the calling thread
+     * 
+     * @return Allocation count
+     */
+    static uint64_t count();
+    
+    /**
+     * @brief Get the number of bytes allocated by the calling thread
+     * 
+     * @return Allocated bytes
+     */
+    static uint64_t bytes();
+    
+    /**
+     * @brief Check if the counting operator new is linked in
+     * 
+     * @return true if counts are meaningful, false otherwise
+     */
+    static bool isActive();
+};
+
+/**
+ * @brief One point of the benchmark parameter grid
+ */
+struct BenchmarkParams {
+    uint16_t sensorCount;   ///< Sensors contributing readings
+    uint8_t channelCount;   ///< Values per reading
+    uint16_t windowSize;    ///< Filter window / batch size
+    
+    BenchmarkParams() : sensorCount(1), channelCount(1), windowSize(5) {}
+    
+    BenchmarkParams(uint16_t sensors, uint8_t channels, uint16_t window)
+        : sensorCount(sensors), channelCount(channels), windowSize(window) {}
+};
+
+/**
+ * @brief Result of one benchmark case at one grid point
+ */
+struct BenchmarkResult {
+    std::string name;              ///< Case name, e.g. "filter.median"
+    BenchmarkParams params;        ///< Grid point
+    uint64_t iterations;           ///< Timed iterations
+    double nsPerReading;           ///< Median wall time per input reading
+    double allocationsPerReading;  ///< Heap allocations per input reading, -1 if not counted
+    double bytesPerReading;        ///< Output bytes per input reading
+    
+    BenchmarkResult()
+        : name(), params(), iterations(0), nsPerReading(0.0),
+          allocationsPerReading(0.0), bytesPerReading(0.0) {}
+};
+
+/**
+ * @brief Timed body of a benchmark case
+ * 
+ * Processes the input batch once and returns the number of output bytes
+ * produced, or 0 where output size is not meaningful.
+ */
+using BenchmarkBody = std::function<size_t(const std::vector<Sensors::SensorReading>& input)>;
+
+/**
+ * @brief Builds a benchmark body for a grid point
+ * 
+ * Setup done here (constructing filters, warming windows) is not timed.
+ */
+using BenchmarkFactory = std::function<BenchmarkBody(const BenchmarkParams& params)>;
+
+/**
+ * @brief Pipeline benchmark runner class
+ * 
+ * Cases are registered through addCase() by the benchmark target (see
+ * pipeline_benchmark_cases.h), so the runner depends on no pipeline
+ * component and no component depends on the runner.
+ */
+class PipelineBenchmark {
+public:
+    /**
+     * @brief Constructor
+     */
+    PipelineBenchmark();
+    
+    /**
+     * @brief Register a benchmark case
+     * 
+     * @param name Case name, dot-separated by component
+     * @param factory Body factory
+     */
+    void addCase(const std::string& name, BenchmarkFactory factory);
+    
+    /**
+     * @brief Set the parameter grid
+     * 
+     * Every case runs at every combination of the given values.
+     * 
+     * @param sensorCounts Sensor counts
+     * @param channelCounts Channel counts
+     * @param windowSizes Window sizes
+     */
+    void setGrid(
+        const std::vector<uint16_t>& sensorCounts,
+        const std::vector<uint8_t>& channelCounts,
+        const std::vector<uint16_t>& windowSizes
+    );
+    
+    /**
+     * @brief Set how long each case runs per grid point
+     * 
+     * @param minTimeMs Minimum timed duration
+     * @param repetitions Repetitions whose median is reported
+     */
+    void setDuration(uint32_t minTimeMs, uint8_t repetitions);
+    
+    /**
+     * @brief Run the benchmarks
+     * 
+     * @param prefix Only run cases whose name starts with this prefix
+     * @return Results in case and grid order
+     */
+    std::vector<BenchmarkResult> run(const std::string& prefix = "");
+    
+    /**
+     * @brief Generate a deterministic input batch for a grid point
+     * 
+     * @param params Grid point
+     * @param count Number of readings
+     * @param seed Random seed
+     * @return Readings cycling over the sensors
+     */
+    static std::vector<Sensors::SensorReading> makeReadings(const BenchmarkParams& params,
+                                                            size_t count, uint32_t seed = 1);
+    
+    /**
+     * @brief Serialize results as JSON
+     * 
+     * @param results Results
+     * @return JSON array
+     */
+    static std::string toJson(const std::vector<BenchmarkResult>& results);
+    
+    /**
+     * @brief Store results as the regression baseline
+     * 
+     * @param results Results
+     * @param path File path
+     * @return true if successful, false otherwise
+     */
+    static bool saveBaseline(const std::vector<BenchmarkResult>& results,
+                             const std::string& path = DeviceConfig::BENCHMARK_BASELINE_PATH);
+    
+    /**
+     * @brief Compare results with a stored baseline
+     * 
+     * @param results Results
+     * @param regressions Reference to store a description of each regression
+     * @param tolerancePercent Allowed slowdown before a case counts as regressed
+     * @param path Baseline file path
+     * @return true if no case regressed, false otherwise
+     */
+    static bool compareToBaseline(const std::vector<BenchmarkResult>& results,
+                                  std::vector<std::string>& regressions,
+                                  float tolerancePercent = DeviceConfig::BENCHMARK_TOLERANCE_PERCENT,
+                                  const std::string& path = DeviceConfig::BENCHMARK_BASELINE_PATH);
+
+private:
+    struct Case {
+        std::string name;
+        BenchmarkFactory factory;
+    };
+    
+    std::vector<Case> mCases;
+    std::vector<uint16_t> mSensorCounts;
+    std::vector<uint8_t> mChannelCounts;
+    std::vector<uint16_t> mWindowSizes;
+    uint32_t mMinTimeMs;
+    uint8_t mRepetitions;
+    
+    /**
+     * @brief Time one case at one grid point
+     * 
+     * @param benchmarkCase Case
+     * @param params Grid point
+     * @return Result
+     */
+    BenchmarkResult runCase(const Case& benchmarkCase, const BenchmarkParams& params);
+};
+
+} // namespace System
+
+#endif // PIPELINE_BENCHMARK_H
@@ -0,0 +1,47 @@
+/**
+ * @file pipeline_benchmark_cases.h
+ * @brief Benchmark cases of the data and communication pipeline
+ * 
+ * This file belongs to the benchmark target. It registers the pipeline
+ * components with the PipelineBenchmark runner, keeping the runner and
+ * the components free of dependencies on each other.
+ */
+
+#ifndef PIPELINE_BENCHMARK_CASES_H
+#define PIPELINE_BENCHMARK_CASES_H
+
+#include "../system/pipeline_benchmark.h"
+#include "../data/data_filter.h"
+#include "../data/data_processor.h"
+#include "../communication/comm_manager.h"
+#include "../communication/delta_encoder.h"
+
+namespace Benchmarks {
+
+/**
+ * @brief Register the data-layer cases
+ * 
+ * Adds "filter.movingAverage", "filter.threshold", "filter.delta" and
+ * "filter.median", and "processor.process", "processor.aggregate",
+ * "processor.detectAnomalies", "processor.compress" and
+ * "processor.decompress".
+ * 
+ * @param benchmark Benchmark runner
+ */
+void registerDataCases(System::PipelineBenchmark& benchmark);
+
+/**
+ * @brief Register the serialization cases
+ * 
+ * Adds "comm.sensorDataToJson", timed through
+ * CommManager::serializeSensorData(), and "comm.delta", timed on a
+ * standalone DeltaEncoder. Nothing is published.
+ * 
+ * @param benchmark Benchmark runner
+ * @param comm Communication manager used for serialization only
+ */
+void registerCommCases(System::PipelineBenchmark& benchmark, Communication::CommManager& comm);
+
+} // namespace Benchmarks
+
+#endif // PIPELINE_BENCHMARK_CASES_H
@@ -0,0 +1,157 @@
+/**
+ * @file replay_sensor.h
+ * @brief Sensor that plays back recorded traces
+ * 
+ * This file provides a sensor implementation that replays readings
+ * captured by Storage::TraceRecorder, so production load can be fed
+ * through the real filters, processor and communication stack on a
+ * workstation without the original hardware.
+ */
+
+#ifndef REPLAY_SENSOR_H
+#define REPLAY_SENSOR_H
+
+#include <chrono>
+#include <string>
+#include "sensor_base.h"
+#include "../storage/trace_recorder.h"
+
+namespace Sensors {
+
+/**
+ * @brief Replay sensor class
+ * 
+ * Each instance replays the readings of one recorded sensor (or of all
+ * of them) and paces read() so the original inter-reading intervals are
+ * reproduced, scaled by the speed factor.
+ */
+class ReplaySensor : public SensorBase {
+public:
+    static constexpr SensorId ALL_SENSORS = INVALID_SENSOR_ID;
+    
+    /**
+     * @brief Constructor for replay sensor
+     * 
+     * @param id Unique sensor identifier
+     * @param name Human-readable name of the sensor
+     * @param tracePath Recording to replay
+     * @param sourceSensorId Recorded sensor to replay, ALL_SENSORS for every record
+     * @param speed Playback speed, 1.0 for real time, 0 to replay as fast as possible
+     */
+    ReplaySensor(SensorId id,
+                 const std::string& name,
+                 const std::string& tracePath,
+                 SensorId sourceSensorId = ALL_SENSORS,
+                 float speed = 1.0f);
+    
+    /**
+     * @brief Destructor
+     */
+    virtual ~ReplaySensor();
+    
+    /**
+     * @brief Open the recording
+     * 
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize() override;
+    
+    /**
+     * @brief Return the next recorded reading
+     * 
+     * Blocks until the reading is due. The sensor ID is replaced with
+     * this sensor's ID and the timestamp with the replay time unless
+     * setPreserveOriginal() was called. At the end of the trace the
+     * reading is invalid and the state becomes ERROR, unless looping.
+     * Recorded values are treated as raw; read() applies any calibration set.
+     * 
+     * @return SensorReading object containing the recorded values
+     */
+    SensorReading readRaw() override;
+    
+    /**
+     * @brief Replayed sensors need no calibration
+     * 
+     * @return true
+     */
+    bool calibrate() override;
+    
+    /**
+     * @brief Pause playback
+     * 
+     * @return true
+     */
+    bool sleep() override;
+    
+    /**
+     * @brief Resume playback, re-anchoring the replay clock
+     * 
+     * @return true
+     */
+    bool wakeUp() override;
+    
+    /**
+     * @brief Check that the recording contains readings for this sensor
+     * 
+     * @return true if self-test passed, false otherwise
+     */
+    bool selfTest() override;
+    
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * @return Empty, replay sensors share no bus
+     */
+    std::string getBusKey() const override;
+    
+    /**
+     * @brief Set the playback speed
+     * 
+     * @param speed Speed factor, 0 to replay as fast as possible
+     */
+    void setSpeed(float speed);
+    
+    /**
+     * @brief Restart from the beginning when the trace ends
+     * 
+     * @param loop Whether to loop
+     */
+    void setLoop(bool loop);
+    
+    /**
+     * @brief Keep the recorded sensor IDs and timestamps
+     * 
+     * @param preserve Whether to keep the original values
+     */
+    void setPreserveOriginal(bool preserve);
+    
+    /**
+     * @brief Get the number of readings replayed
+     * 
+     * @return Replayed reading count
+     */
+    uint64_t getReplayedCount() const;
+
+private:
+    std::string mTracePath;
+    SensorId mSourceSensorId;
+    float mSpeed;
+    bool mLoop;
+    bool mPreserveOriginal;
+    Storage::TraceReader mReader;
+    uint64_t mTraceAnchorMs;                                ///< Trace time at mReplayAnchor
+    std::chrono::steady_clock::time_point mReplayAnchor;    ///< Wall time of mTraceAnchorMs
+    uint64_t mReplayedCount;
+    
+    /**
+     * @brief Read the next record for this sensor, looping if enabled
+     * 
+     * @param reading Reference to store the reading
+     * @return true if a record was found, false at the end of the trace
+     */
+    bool nextRecord(SensorReading& reading);
+};
+
+} // namespace Sensors
+
+#endif // REPLAY_SENSOR_H
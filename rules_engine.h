@@ -0,0 +1,312 @@
+/**
+ * @file rules_engine.h
+ * @brief Edge rules compiled to bytecode
+ * 
+ * This file provides a small rules language for reacting to readings on
+ * the device, a compiler that turns rules into bytecode for a
+ * register-based virtual machine, and an engine that evaluates the
+ * rules for a sensor on each of its readings.
+ * 
+ * Rule syntax, one rule per line, '#' starts a comment:
+ * 
+ *   rule <name> on <sensorId|*> when <expr> [for <n>(ms|s|m)]
+ *        then <LOW|NORMAL|HIGH|CRITICAL> "<message>" [every <n>(ms|s|m)]
+ * 
+ * Expressions use the channel values v0..v15, numeric literals, the
+ * operators + - * / < <= > >= == != && || ! and the functions abs(),
+ * min() and max(). Example:
+ * 
+ *   rule overheat on 3 when v0 > 80 for 30s then CRITICAL "Overheating" every 5m
+ * 
+ * "for" requires the condition to hold continuously for the duration;
+ * "every" is the minimum interval between two firings and defaults to
+ * RULES_DEFAULT_INTERVAL_MS, so a held condition does not fire on every
+ * reading ("every 0ms" opts into that). Both are tracked per sensor, so
+ * a wildcard rule holds and fires independently for each sensor.
+ */
+
+#ifndef RULES_ENGINE_H
+#define RULES_ENGINE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "../system/error_handler.h"
+
+namespace Communication {
+enum class MessagePriority;
+}
+
+namespace Data {
+
+/**
+ * @brief VM opcodes
+ * 
+ * Operands a, b and c are register numbers unless noted.
+ */
+enum class RuleOpcode : uint8_t {
+    LOAD_CHANNEL,   ///< r[a] = channel b of the reading, 0 if missing
+    LOAD_CONST,     ///< r[a] = constants[b | c << 8]
+    ADD,            ///< r[a] = r[b] + r[c]
+    SUB,            ///< r[a] = r[b] - r[c]
+    MUL,            ///< r[a] = r[b] * r[c]
+    DIV,            ///< r[a] = r[b] / r[c]
+    NEG,            ///< r[a] = -r[b]
+    ABS,            ///< r[a] = |r[b]|
+    MIN,            ///< r[a] = min(r[b], r[c])
+    MAX,            ///< r[a] = max(r[b], r[c])
+    LT,             ///< r[a] = r[b] < r[c]
+    LE,             ///< r[a] = r[b] <= r[c]
+    GT,             ///< r[a] = r[b] > r[c]
+    GE,             ///< r[a] = r[b] >= r[c]
+    EQ,             ///< r[a] = r[b] == r[c]
+    NE,             ///< r[a] = r[b] != r[c]
+    NOT,            ///< r[a] = !r[b]
+    JUMP_IF_FALSE,  ///< if !r[a] jump to instruction b | c << 8 (short-circuit &&)
+    JUMP_IF_TRUE,   ///< if r[a] jump to instruction b | c << 8 (short-circuit ||)
+    RETURN          ///< result = r[a] != 0
+};
+
+/**
+ * @brief One VM instruction
+ */
+struct RuleInstruction {
+    RuleOpcode op;
+    uint8_t a;
+    uint8_t b;
+    uint8_t c;
+};
+
+/**
+ * @brief Compiled rule
+ */
+struct CompiledRule {
+    static constexpr Sensors::SensorId ANY_SENSOR = Sensors::INVALID_SENSOR_ID;
+    
+    std::string name;                           ///< Rule name
+    Sensors::SensorId sensorId;                 ///< Sensor the rule applies to, ANY_SENSOR for all
+    std::vector<RuleInstruction> program;       ///< Condition bytecode
+    std::vector<float> constants;               ///< Constant pool
+    uint8_t registerCount;                      ///< Registers used by the program
+    uint32_t holdMs;                            ///< Time the condition must hold before firing
+    uint32_t intervalMs;                        ///< Minimum time between firings per sensor
+    Communication::MessagePriority priority;    ///< Priority of the action message
+    std::string message;                        ///< Action message
+    
+    CompiledRule()
+        : name(), sensorId(ANY_SENSOR), program(), constants(), registerCount(0),
+          holdMs(0), intervalMs(DeviceConfig::RULES_DEFAULT_INTERVAL_MS), priority(), message() {}
+};
+
+/**
+ * @brief Rule firing passed to the action callback
+ */
+struct RuleFiring {
+    const CompiledRule* rule;                 ///< Rule that fired
+    const Sensors::SensorReading* reading;    ///< Reading that triggered it
+    uint64_t conditionSince;                  ///< When the condition started to hold (ms)
+};
+
+/**
+ * @brief Rule action callback type
+ */
+using RuleActionCallback = std::function<void(const RuleFiring&)>;
+
+/**
+ * @brief Rules compiler class
+ * 
+ * A recursive-descent parser that emits register code directly, with
+ * constant folding of literal subexpressions.
+ */
+class RuleCompiler {
+public:
+    static constexpr uint8_t MAX_REGISTERS = DeviceConfig::RULES_MAX_REGISTERS;
+    static constexpr uint8_t MAX_CHANNELS = 16;
+    
+    /**
+     * @brief Compile a rule set
+     * 
+     * @param source Rules source text
+     * @param rules Reference to store the compiled rules
+     * @return true if every rule compiled, false otherwise
+     */
+    bool compile(const std::string& source, std::vector<CompiledRule>& rules);
+    
+    /**
+     * @brief Get the error of the last failed compile
+     * 
+     * @return Message with line and column, e.g. "3:18: expected ')'"
+     */
+    const std::string& getError() const;
+
+private:
+    std::string mError;
+};
+
+/**
+ * @brief Register-based rule VM
+ */
+class RuleVM {
+public:
+    /**
+     * @brief Evaluate a rule condition
+     * 
+     * Runs without allocating; registers live on the stack.
+     * 
+     * @param rule Compiled rule
+     * @param values Channel values of the reading
+     * @param count Number of channel values
+     * @return Condition result
+     */
+    static bool evaluate(const CompiledRule& rule, const float* values, size_t count);
+};
+
+/**
+ * @brief Rules engine statistics
+ */
+struct RulesEngineStats {
+    uint64_t readings;      ///< Readings evaluated
+    uint64_t evaluations;   ///< Rule conditions evaluated
+    uint64_t firings;       ///< Actions fired
+    uint64_t suppressed;    ///< Firings suppressed by the rule interval
+    
+    RulesEngineStats() : readings(0), evaluations(0), firings(0), suppressed(0) {}
+};
+
+/**
+ * @brief Rules engine class
+ * 
+ * Rules are indexed by sensor, so a reading only runs the rules for
+ * its sensor plus the wildcard rules. The index is private to the rule
+ * set: sensor IDs named in remotely loaded rules are never added to
+ * the SensorRegistry. Rule sets are swapped atomically
+ * by loadRules(); hold and interval state is kept per (rule, sensor)
+ * and survives a reload for rules whose name is kept.
+ */
+class RulesEngine {
+public:
+    /**
+     * @brief Constructor
+     */
+    RulesEngine();
+    
+    /**
+     * @brief Destructor
+     */
+    ~RulesEngine();
+    
+    /**
+     * @brief Compile and install a rule set
+     * 
+     * @param source Rules source text
+     * @return true if successful, false if the source did not compile (the
+     *         current rules stay installed)
+     */
+    bool loadRules(const std::string& source);
+    
+    /**
+     * @brief Compile and install a rule set from a file
+     * 
+     * @param path File path
+     * @return true if successful, false otherwise
+     */
+    bool loadFromFile(const std::string& path = DeviceConfig::RULES_PATH);
+    
+    /**
+     * @brief Set the action callback
+     * 
+     * @param callback Called for each firing on the evaluating thread
+     */
+    void setActionCallback(RuleActionCallback callback);
+    
+    /**
+     * @brief Evaluate the rules for a batch of readings
+     * 
+     * Invalid readings and readings from sensors not in the
+     * SensorRegistry are skipped.
+     * 
+     * @param readings Readings
+     * @return Number of rules fired
+     */
+    size_t evaluate(const std::vector<Sensors::SensorReading>& readings);
+    
+    /**
+     * @brief Get the number of installed rules
+     * 
+     * @return Rule count
+     */
+    size_t getRuleCount() const;
+    
+    /**
+     * @brief Get the compile error of the last failed load
+     * 
+     * @return Error message
+     */
+    std::string getCompileError() const;
+    
+    /**
+     * @brief Get engine statistics
+     * 
+     * @return Statistics
+     */
+    RulesEngineStats getStats() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    struct RuleState {
+        uint64_t conditionSince;  ///< When the condition started to hold, 0 if it does not
+        uint64_t lastFired;       ///< Last firing time, 0 if never
+        
+        RuleState() : conditionSince(0), lastFired(0) {}
+    };
+    
+    struct RuleSet {
+        std::vector<CompiledRule> rules;
+        std::vector<Sensors::SensorTable<RuleState>> states;    ///< Parallel to rules, per sensor
+        std::map<Sensors::SensorId, std::vector<uint32_t>> bySensor; ///< Rule indices per named sensor
+        std::vector<uint32_t> anySensor;                        ///< Wildcard rule indices
+    };
+    
+    std::shared_ptr<RuleSet> mRules;
+    RuleActionCallback mCallback;
+    RulesEngineStats mStats;
+    std::string mCompileError;
+    System::ErrorCode mLastError;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Evaluate one rule against a reading and fire it if due
+     * 
+     * Uses the rule's state for the reading's sensor, created with
+     * SensorTable::getOrCreateRegistered().
+     * 
+     * @param set Rule set
+     * @param index Rule index
+     * @param reading Reading
+     * @return true if the rule fired, false otherwise
+     */
+    bool evaluateRule(RuleSet& set, uint32_t index, const Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Data
+
+#endif // RULES_ENGINE_H
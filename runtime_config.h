@@ -0,0 +1,233 @@
+/**
+ * @file runtime_config.h
+ * @brief Runtime-reloadable configuration
+ * 
+ * This file provides a configuration layer on top of the compile-time
+ * defaults in config.h. Tunables can be changed from a file or a remote
+ * command; each change publishes a new immutable snapshot that hot
+ * paths read without locking, and subscribed components apply it live.
+ */
+
+#ifndef RUNTIME_CONFIG_H
+#define RUNTIME_CONFIG_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_registry.h"
+#include "../system/error_handler.h"
+
+namespace System {
+
+/**
+ * @brief Snapshot of runtime-tunable settings
+ * 
+ * Defaults come from DeviceConfig. Snapshots are immutable once
+ * published.
+ */
+struct RuntimeConfig {
+    uint64_t version;                        ///< Incremented on every change
+    uint32_t samplingRateMs;                 ///< Default sensor sampling rate
+    std::map<Sensors::SensorId, uint32_t> sensorSamplingRateMs; ///< Per-sensor overrides
+    uint16_t dataBatchSize;                  ///< Readings per transmitted batch
+    std::map<std::string, std::map<std::string, float>> filterParams; ///< Parameters by filter ID
+    uint32_t uplinkBytesPerSec;              ///< Global uplink byte budget
+    uint32_t uplinkMessagesPerSec;           ///< Global uplink message budget
+    uint32_t statusIntervalMs;               ///< Status update interval
+    uint32_t journalSyncIntervalMs;          ///< Journal group commit interval
+    DeviceConfig::LogLevel logLevel;         ///< Runtime log level, never below CURRENT_LOG_LEVEL
+    
+    RuntimeConfig()
+        : version(0),
+          samplingRateMs(DeviceConfig::DEFAULT_SAMPLING_RATE_MS),
+          sensorSamplingRateMs(),
+          dataBatchSize(DeviceConfig::DATA_BATCH_SIZE),
+          filterParams(),
+          uplinkBytesPerSec(DeviceConfig::UPLINK_BYTES_PER_SEC),
+          uplinkMessagesPerSec(DeviceConfig::UPLINK_MESSAGES_PER_SEC),
+          statusIntervalMs(DeviceConfig::STATUS_INTERVAL_MS),
+          journalSyncIntervalMs(DeviceConfig::JOURNAL_SYNC_INTERVAL_MS),
+          logLevel(DeviceConfig::CURRENT_LOG_LEVEL) {}
+};
+
+/**
+ * @brief Configuration change callback type
+ * 
+ * Called on the updating thread with the previous and the new snapshot.
+ */
+using ConfigChangeCallback = std::function<void(const RuntimeConfig&, const RuntimeConfig&)>;
+
+/**
+ * @brief Runtime configuration manager class
+ * 
+ * Updates follow read-copy-update: the writer copies the current
+ * snapshot, modifies and validates the copy, then publishes it with an
+ * atomic pointer swap. Readers keep the snapshot they hold alive through
+ * shared ownership, so an old snapshot is freed only after its last
+ * reader drops it.
+ */
+class ConfigManager {
+public:
+    /**
+     * @brief Constructor
+     */
+    ConfigManager();
+    
+    /**
+     * @brief Destructor
+     */
+    ~ConfigManager();
+    
+    /**
+     * @brief Get the current snapshot
+     * 
+     * @return Current snapshot
+     */
+    std::shared_ptr<const RuntimeConfig> current() const {
+        return std::atomic_load_explicit(&mCurrent, std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Get the version of the current snapshot
+     * 
+     * A single acquire load, used by ConfigReader to detect changes.
+     * 
+     * @return Current version
+     */
+    uint64_t version() const {
+        return mVersion.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Load settings from a JSON file
+     * 
+     * @param path File path
+     * @return true if the file was valid and applied, false otherwise
+     */
+    bool loadFromFile(const std::string& path = DeviceConfig::RUNTIME_CONFIG_PATH);
+    
+    /**
+     * @brief Persist the current snapshot so it survives a restart
+     * 
+     * Writes to a temporary file and renames it over the target.
+     * 
+     * @param path File path
+     * @return true if successful, false otherwise
+     */
+    bool saveToFile(const std::string& path = DeviceConfig::RUNTIME_CONFIG_PATH) const;
+    
+    /**
+     * @brief Apply a partial update in JSON form
+     * 
+     * Accepts the payload of a MQTT_TOPIC_CONFIG command, e.g.
+     * {"samplingRateMs":500,"filters":{"ma1":{"windowSize":8}}}.
+     * Unknown keys or out-of-range values reject the whole update.
+     * 
+     * @param json Partial configuration
+     * @param error Reference to store a description of a rejection
+     * @return true if applied, false otherwise
+     */
+    bool applyJson(std::string_view json, std::string& error);
+    
+    /**
+     * @brief Apply an update function to a copy of the current snapshot
+     * 
+     * @param mutator Function modifying the copy
+     * @return true if the result was valid and published, false otherwise
+     */
+    bool update(const std::function<void(RuntimeConfig&)>& mutator);
+    
+    /**
+     * @brief Subscribe to configuration changes
+     * 
+     * @param callback Function to call after each published change
+     * @return Subscription identifier
+     */
+    uint32_t subscribe(ConfigChangeCallback callback);
+    
+    /**
+     * @brief Cancel a subscription
+     * 
+     * @param id Subscription identifier
+     */
+    void unsubscribe(uint32_t id);
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    std::shared_ptr<const RuntimeConfig> mCurrent;
+    std::atomic<uint64_t> mVersion;
+    std::map<uint32_t, ConfigChangeCallback> mSubscribers;
+    uint32_t mNextSubscription;
+    std::mutex mUpdateMutex;   ///< Serializes writers only
+    System::ErrorCode mLastError;
+    
+    /**
+     * @brief Check a candidate snapshot for invalid values
+     * 
+     * @param config Candidate snapshot
+     * @param error Reference to store a description of the problem
+     * @return true if valid, false otherwise
+     */
+    static bool validate(const RuntimeConfig& config, std::string& error);
+    
+    /**
+     * @brief Publish a snapshot and notify subscribers
+     * 
+     * @param config New snapshot
+     */
+    void publish(std::shared_ptr<const RuntimeConfig> config);
+};
+
+/**
+ * @brief Per-thread cached view of the configuration
+ * 
+ * Hot paths keep one reader per thread; get() costs one atomic load
+ * unless the configuration changed since the last call.
+ */
+class ConfigReader {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param manager Configuration manager
+     */
+    explicit ConfigReader(const ConfigManager& manager)
+        : mManager(manager), mSnapshot(manager.current()),
+          mVersion(mSnapshot ? mSnapshot->version : 0) {}
+    
+    /**
+     * @brief Get the latest snapshot
+     * 
+     * @return Snapshot, valid until the next call
+     */
+    const RuntimeConfig& get() {
+        uint64_t version = mManager.version();
+        if (version != mVersion) {
+            mSnapshot = mManager.current();
+            mVersion = mSnapshot->version;
+        }
+        return *mSnapshot;
+    }
+
+private:
+    const ConfigManager& mManager;
+    std::shared_ptr<const RuntimeConfig> mSnapshot;
+    uint64_t mVersion;
+};
+
+} // namespace System
+
+#endif // RUNTIME_CONFIG_H
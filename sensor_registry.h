@@ -0,0 +1,238 @@
+/**
+ * @file sensor_registry.h
+ * @brief Sensor identities and their dense internal indices
+ * 
+ * This file defines the sensor ID type and a process-wide registry that
+ * maps sparse sensor IDs (e.g. bus, device and Modbus sub-device packed
+ * into 32 bits) to dense indices 0..MAX_SENSORS-1, so per-sensor state
+ * can be kept in compact arrays instead of maps.
+ */
+
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../config.h"
+
+namespace Sensors {
+
+/**
+ * @brief Sensor identifier as carried in readings and on the wire
+ */
+using SensorId = uint32_t;
+
+/**
+ * @brief Dense per-process sensor index
+ */
+using SensorIndex = uint16_t;
+
+constexpr SensorId INVALID_SENSOR_ID = 0xFFFFFFFF;
+constexpr SensorIndex INVALID_SENSOR_INDEX = 0xFFFF;
+
+static_assert(DeviceConfig::MAX_SENSORS < INVALID_SENSOR_INDEX, "MAX_SENSORS must fit SensorIndex");
+
+/**
+ * @brief Sensor registry class
+ * 
+ * Lookups are lock-free probes of an open-addressed table; registration
+ * takes a mutex. Entries are never removed, so an index stays valid for
+ * the lifetime of the process.
+ */
+class SensorRegistry {
+public:
+    /**
+     * @brief Get the process-wide registry
+     * 
+     * @return Registry instance
+     */
+    static SensorRegistry& instance();
+    
+    /**
+     * @brief Register a sensor ID
+     * 
+     * Registering an ID twice returns the same index.
+     * 
+     * @param id Sensor ID
+     * @return Dense index, INVALID_SENSOR_INDEX if the ID is invalid or MAX_SENSORS is reached
+     */
+    SensorIndex registerSensor(SensorId id);
+    
+    /**
+     * @brief Look up the index of a sensor ID
+     * 
+     * @param id Sensor ID
+     * @return Dense index, INVALID_SENSOR_INDEX if not registered
+     */
+    SensorIndex indexOf(SensorId id) const {
+        size_t slot = hash(id) & (TABLE_SIZE - 1);
+        for (size_t probe = 0; probe < TABLE_SIZE; ++probe) {
+            uint64_t entry = mTable[slot].load(std::memory_order_acquire);
+            if (entry == 0) {
+                return INVALID_SENSOR_INDEX;
+            }
+            if (static_cast<SensorId>(entry >> 32) == id) {
+                return static_cast<SensorIndex>((entry & 0xFFFFFFFF) - 1);
+            }
+            slot = (slot + 1) & (TABLE_SIZE - 1);
+        }
+        return INVALID_SENSOR_INDEX;
+    }
+    
+    /**
+     * @brief Get the sensor ID of an index
+     * 
+     * @param index Dense index
+     * @return Sensor ID, INVALID_SENSOR_ID if the index is not assigned
+     */
+    SensorId idAt(SensorIndex index) const;
+    
+    /**
+     * @brief Get the number of registered sensors
+     * 
+     * @return Sensor count
+     */
+    size_t size() const;
+
+private:
+    static constexpr size_t TABLE_SIZE = [] {
+        size_t size = 1;
+        while (size < 2 * static_cast<size_t>(DeviceConfig::MAX_SENSORS)) {
+            size <<= 1;
+        }
+        return size;
+    }();
+    
+    std::unique_ptr<std::atomic<uint64_t>[]> mTable;  ///< (id << 32) | (index + 1), 0 if empty
+    std::unique_ptr<SensorId[]> mIds;                 ///< Sensor ID by index
+    std::atomic<size_t> mCount;
+    std::mutex mMutex;
+    
+    SensorRegistry();
+    ~SensorRegistry();
+    SensorRegistry(const SensorRegistry&) = delete;
+    SensorRegistry& operator=(const SensorRegistry&) = delete;
+    
+    /**
+     * @brief Mix the bits of a sensor ID
+     * 
+     * Packed IDs differ mostly in their low bits per bus, so they are
+     * mixed before probing.
+     * 
+     * @param id Sensor ID
+     * @return Hash
+     */
+    static uint32_t hash(SensorId id) {
+        id ^= id >> 16;
+        id *= 0x7FEB352Du;
+        id ^= id >> 15;
+        id *= 0x846CA68Bu;
+        id ^= id >> 16;
+        return id;
+    }
+};
+
+/**
+ * @brief Per-sensor state table indexed by dense sensor index
+ * 
+ * Replaces std::map<SensorId, T> for per-sensor state: one registry
+ * probe and an array access per lookup. For sensors of this device
+ * only; IDs read from recordings or other devices are kept in plain
+ * maps so they neither register nor go missing. Not thread-safe; each
+ * owner (e.g. a filter) synchronizes its own access.
+ */
+template <typename T>
+class SensorTable {
+public:
+    /**
+     * @brief Get the state of a sensor, creating it if needed
+     * 
+     * @param id Sensor ID, registered if unknown
+     * @return State, or nullptr if the registry is full
+     */
+    T* getOrCreate(SensorId id) {
+        SensorRegistry& registry = SensorRegistry::instance();
+        SensorIndex index = registry.indexOf(id);
+        if (index == INVALID_SENSOR_INDEX) {
+            index = registry.registerSensor(id);
+            if (index == INVALID_SENSOR_INDEX) {
+                return nullptr;
+            }
+        }
+        if (index >= mValues.size()) {
+            mValues.resize(index + 1);
+            mPresent.resize(index + 1, 0);
+        }
+        mPresent[index] = 1;
+        return &mValues[index];
+    }
+    
+    /**
+     * @brief Get the state of a registered sensor, creating it if needed
+     * 
+     * Unlike getOrCreate(), never registers the ID, so IDs taken from
+     * untrusted input cannot fill the registry.
+     * 
+     * @param id Sensor ID
+     * @return State, or nullptr if the ID is not registered
+     */
+    T* getOrCreateRegistered(SensorId id) {
+        SensorIndex index = SensorRegistry::instance().indexOf(id);
+        if (index == INVALID_SENSOR_INDEX) {
+            return nullptr;
+        }
+        if (index >= mValues.size()) {
+            mValues.resize(index + 1);
+            mPresent.resize(index + 1, 0);
+        }
+        mPresent[index] = 1;
+        return &mValues[index];
+    }
+    
+    /**
+     * @brief Get the state of a sensor
+     * 
+     * @param id Sensor ID
+     * @return State, or nullptr if the sensor has none
+     */
+    T* find(SensorId id) {
+        SensorIndex index = SensorRegistry::instance().indexOf(id);
+        if (index >= mValues.size() || mPresent[index] == 0) {
+            return nullptr;
+        }
+        return &mValues[index];
+    }
+    
+    /**
+     * @brief Drop the state of a sensor
+     * 
+     * @param id Sensor ID
+     */
+    void erase(SensorId id) {
+        SensorIndex index = SensorRegistry::instance().indexOf(id);
+        if (index < mValues.size()) {
+            mValues[index] = T();
+            mPresent[index] = 0;
+        }
+    }
+    
+    /**
+     * @brief Drop all state
+     */
+    void clear() {
+        mValues.clear();
+        mPresent.clear();
+    }
+
+private:
+    std::vector<T> mValues;
+    std::vector<uint8_t> mPresent;
+};
+
+} // namespace Sensors
+
+#endif // SENSOR_REGISTRY_H
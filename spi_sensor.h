@@ -38,7 +38,7 @@ public:
      * @param mode SPI mode (0-3)
      * @param speedHz SPI clock frequency in Hz
      */
-    SPISensor(uint8_t id, 
+    SPISensor(SensorId id, 
               const std::string& name, 
               uint8_t spiBus, 
               uint8_t chipSelect, 
@@ -58,11 +58,11 @@ public:
     bool initialize() override;
     
     /**
-     * @brief Read data from the SPI sensor
+     * @brief Read raw data from the SPI sensor
      * 
-     * @return SensorReading object containing the measured values
+     * @return SensorReading object containing the uncalibrated values
      */
-    SensorReading read() override;
+    SensorReading readRaw() override;
     
     /**
      * @brief Calibrate the SPI sensor
@@ -92,6 +92,13 @@ public:
      */
     bool selfTest() override;
     
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * @return "spi-<bus>"
+     */
+    std::string getBusKey() const override;
+    
     /**
      * @brief Transfer data over SPI
      * 
@@ -0,0 +1,220 @@
+/**
+ * @file startup_orchestrator.h
+ * @brief Parallel sensor bring-up with deferred self-test and calibration
+ * 
+ * This file provides the startup sequence for the sensor set. Sensors on
+ * different buses are initialized concurrently (sensors sharing a bus
+ * stay sequential), non-critical self-tests and calibrations are deferred
+ * until data is flowing, and calibration results are cached on disk so
+ * warm restarts can skip them.
+ */
+
+#ifndef STARTUP_ORCHESTRATOR_H
+#define STARTUP_ORCHESTRATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "../sensors/calibration.h"
+#include "../system/logger.h"
+#include "../system/runtime_config.h"
+
+namespace System {
+
+/**
+ * @brief Startup policy of a sensor
+ */
+struct SensorStartupPolicy {
+    bool critical;             ///< Boot fails if the sensor does not come up
+    bool selfTestBeforeData;   ///< Run selfTest() before the first sample
+    bool calibrateBeforeData;  ///< Run calibrate() before the first sample
+    
+    SensorStartupPolicy()
+        : critical(false),
+          selfTestBeforeData(!DeviceConfig::STARTUP_DEFER_SELF_TEST),
+          calibrateBeforeData(false) {}
+};
+
+/**
+ * @brief Boot timing of one sensor
+ */
+struct SensorBootTiming {
+    Sensors::SensorId sensorId; ///< Sensor identifier
+    std::string name;          ///< Sensor name
+    std::string busKey;        ///< Bus the sensor was initialized on
+    uint32_t initializeMs;     ///< Time spent in initialize()
+    uint32_t selfTestMs;       ///< Time spent in selfTest()
+    uint32_t calibrateMs;      ///< Time spent in calibrate() or restoring from cache
+    bool calibrationCached;    ///< Whether calibration was restored from the cache
+    bool deferred;             ///< Whether self-test/calibration ran after data started
+    bool ok;                   ///< Whether the sensor came up
+    
+    SensorBootTiming()
+        : sensorId(0), name(), busKey(), initializeMs(0), selfTestMs(0),
+          calibrateMs(0), calibrationCached(false), deferred(false), ok(false) {}
+};
+
+/**
+ * @brief Boot-time breakdown
+ */
+struct BootReport {
+    uint32_t totalInitializeMs;    ///< Wall time of the parallel initialization phase
+    uint32_t timeToFirstSampleMs;  ///< Wall time until sensors were ready to sample
+    uint32_t deferredWorkMs;       ///< Wall time of deferred self-tests and calibrations
+    uint32_t cacheHits;            ///< Calibrations restored from the cache
+    std::vector<SensorBootTiming> sensors; ///< Per-sensor timing
+    
+    BootReport()
+        : totalInitializeMs(0), timeToFirstSampleMs(0), deferredWorkMs(0),
+          cacheHits(0), sensors() {}
+};
+
+/**
+ * @brief Startup orchestrator class
+ */
+class StartupOrchestrator {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param cacheDirectory Directory of the calibration cache
+     */
+    explicit StartupOrchestrator(const std::string& cacheDirectory = DeviceConfig::CALIBRATION_CACHE_PATH);
+    
+    /**
+     * @brief Destructor, waits for deferred work and unsubscribes from the configuration
+     */
+    ~StartupOrchestrator();
+    
+    /**
+     * @brief Add a sensor to the startup sequence
+     * 
+     * Sensors sharing a non-empty getBusKey() join that bus's group; a
+     * sensor with an empty key has no shared bus and gets a group, and
+     * so a bring-up thread, of its own.
+     * 
+     * @param sensor Sensor
+     * @param policy Startup policy
+     */
+    void addSensor(std::shared_ptr<Sensors::SensorBase> sensor,
+                   const SensorStartupPolicy& policy = SensorStartupPolicy());
+    
+    /**
+     * @brief Apply runtime configuration to the sensors and the logger
+     * 
+     * Applies the current snapshot right away and subscribes to changes:
+     * each sensor gets its sensorSamplingRateMs override, or
+     * samplingRateMs, through setSamplingRate(), and logLevel is passed
+     * to Logger::setLevel(). Sensors added later get the current rate
+     * in addSensor().
+     * 
+     * @param config Configuration manager
+     */
+    void attachConfigManager(std::shared_ptr<ConfigManager> config);
+    
+    /**
+     * @brief Bring sensors up to the point where they can be sampled
+     * 
+     * Runs one thread per bus (at most STARTUP_MAX_PARALLEL_BUSES) that
+     * initializes the bus's sensors in order, restores cached calibration
+     * or calibrates when the policy requires it, and runs required
+     * self-tests.
+     * 
+     * @return false if a critical sensor failed, true otherwise
+     */
+    bool startSensors();
+    
+    /**
+     * @brief Run deferred self-tests and calibrations in the background
+     * 
+     * Call once acquisition is running. No lock is held across a deferred
+     * selfTest() or calibrate(): drivers take the bus mutex per
+     * transaction (see SensorBase::calibrate()), so acquisition on the
+     * bus is delayed by at most one transaction, not by the whole
+     * routine, and supervised stages keep their deadlines. Calibration
+     * results set by calibrate() are written to the calibration cache.
+     */
+    void startDeferredWork();
+    
+    /**
+     * @brief Wait for deferred work to finish
+     */
+    void waitForDeferredWork();
+    
+    /**
+     * @brief Get the boot-time breakdown
+     * 
+     * @return Boot report
+     */
+    BootReport getReport() const;
+    
+    /**
+     * @brief Format the boot report as a JSON object
+     * 
+     * @return Report as JSON, for the status topic or the log
+     */
+    std::string reportToJson() const;
+
+private:
+    /**
+     * @brief Sensor and its startup state
+     */
+    struct Entry {
+        std::shared_ptr<Sensors::SensorBase> sensor;
+        SensorStartupPolicy policy;
+        bool needsSelfTest;
+        bool needsCalibration;
+        size_t timingIndex;
+    };
+    
+    Sensors::CalibrationCache mCalibrationCache;
+    std::vector<std::vector<Entry>> mBuses;   ///< Entries grouped by bus, in registration order
+    std::map<std::string, size_t> mBusIndex;  ///< Bus key to mBuses index, empty keys excluded
+    std::vector<std::thread> mDeferredThreads;
+    BootReport mReport;
+    std::shared_ptr<ConfigManager> mConfigManager;
+    uint32_t mConfigSubscription;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Bring up the sensors of one bus
+     * 
+     * @param entries Sensors on the bus, in registration order
+     */
+    void startBus(std::vector<Entry>& entries);
+    
+    /**
+     * @brief Restore calibration from the cache if it is fresh
+     * 
+     * @param sensor Sensor
+     * @return true if restored, false if the sensor must calibrate
+     */
+    bool restoreCalibration(Sensors::SensorBase& sensor);
+    
+    /**
+     * @brief Write a sensor's calibration data to the cache
+     * 
+     * @param sensor Sensor
+     * @return true if successful, false otherwise
+     */
+    bool storeCalibration(const Sensors::SensorBase& sensor);
+    
+    /**
+     * @brief Apply the sampling rate a snapshot gives a sensor
+     * 
+     * @param sensor Sensor
+     * @param config Configuration snapshot
+     */
+    static void applySamplingRate(Sensors::SensorBase& sensor, const RuntimeConfig& config);
+};
+
+} // namespace System
+
+#endif // STARTUP_ORCHESTRATOR_H
@@ -0,0 +1,246 @@
+/**
+ * @file status_registry.h
+ * @brief Structured device status with incremental serialization
+ * 
+ * This file provides a registry of device status fields (sensor states,
+ * error counters, queue depths, link statistics) that tracks which
+ * fields changed and serializes only those, without allocating, at
+ * each status interval.
+ */
+
+#ifndef STATUS_REGISTRY_H
+#define STATUS_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "../system/error_handler.h"
+
+namespace Communication {
+
+/**
+ * @brief Status field value types
+ */
+enum class StatusFieldType : uint8_t {
+    BOOL,
+    INTEGER,
+    FLOAT,
+    SENSOR_STATE
+};
+
+/**
+ * @brief Handle of a registered status field
+ */
+using StatusFieldId = uint16_t;
+
+/**
+ * @brief Device status registry class
+ * 
+ * Fields are registered once at startup; after that, setters are
+ * lock-free, only mark a field dirty when its value actually changes,
+ * and may be called from any thread.
+ */
+class DeviceStatusRegistry {
+public:
+    static constexpr StatusFieldId INVALID_FIELD = 0xFFFF;
+    static constexpr size_t MAX_NAME_LENGTH = 32;
+    
+    /**
+     * @brief Constructor
+     * 
+     * @param maxFields Maximum number of fields
+     * @param fullSnapshotInterval Emit all fields every this many serializations
+     */
+    DeviceStatusRegistry(
+        size_t maxFields = DeviceConfig::STATUS_MAX_FIELDS,
+        uint32_t fullSnapshotInterval = DeviceConfig::STATUS_FULL_SNAPSHOT_INTERVAL
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~DeviceStatusRegistry();
+    
+    /**
+     * @brief Register a field
+     * 
+     * The JSON key (quoted name and colon) is preformatted here so
+     * serialization only copies bytes.
+     * 
+     * @param name Field name, e.g. "link.reconnects"
+     * @param type Value type
+     * @return Field handle, or INVALID_FIELD if the registry is full
+     */
+    StatusFieldId registerField(const std::string& name, StatusFieldType type);
+    
+    /**
+     * @brief Register the state field of a sensor
+     * 
+     * @param sensor Sensor to track; the field is named "sensor.<id>.state"
+     * @return Field handle, or INVALID_FIELD if the registry is full
+     */
+    StatusFieldId registerSensor(const Sensors::SensorBase& sensor);
+    
+    /**
+     * @brief Register the counter field of an error code
+     * 
+     * @param code Error code; the field is named "errors.<code>"
+     * @return Field handle, or INVALID_FIELD if the registry is full
+     */
+    StatusFieldId registerErrorCounter(System::ErrorCode code);
+    
+    /**
+     * @brief Set a boolean field
+     * 
+     * @param field Field handle
+     * @param value New value
+     */
+    void setBool(StatusFieldId field, bool value);
+    
+    /**
+     * @brief Set an integer field
+     * 
+     * @param field Field handle
+     * @param value New value
+     */
+    void setInteger(StatusFieldId field, int64_t value);
+    
+    /**
+     * @brief Add to an integer field
+     * 
+     * @param field Field handle
+     * @param delta Amount to add
+     */
+    void addInteger(StatusFieldId field, int64_t delta);
+    
+    /**
+     * @brief Set a float field
+     * 
+     * @param field Field handle
+     * @param value New value
+     */
+    void setFloat(StatusFieldId field, float value);
+    
+    /**
+     * @brief Set a sensor state field
+     * 
+     * @param field Field handle
+     * @param state New state
+     */
+    void setSensorState(StatusFieldId field, Sensors::SensorState state);
+    
+    /**
+     * @brief Serialize changed fields as a JSON object
+     * 
+     * Writes {"seq":n,"full":b,...} with only the dirty fields, or all
+     * fields on every fullSnapshotInterval-th call. Fields that do not
+     * fit stay dirty for the next call. A full snapshot that does not
+     * fit is split: each call writes {"seq":n,"full":true,"part":k,
+     * "last":b,...} with the next fields from mSnapshotCursor until
+     * snapshotPending() is false, and every part has its own sequence.
+     * The dirty bits of the written
+     * fields move to an in-flight snapshot keyed by the sequence; they
+     * are only dropped by onDelivered() and are restored by
+     * onDeliveryFailed(), so a dropped or deferred update is not lost.
+     * 
+     * @param buffer Output buffer
+     * @param capacity Buffer capacity
+     * @param sequence Optional pointer to store the sequence of the update
+     * @return Bytes written, 0 if nothing changed
+     */
+    size_t serializeChanges(char* buffer, size_t capacity, uint32_t* sequence = nullptr);
+    
+    /**
+     * @brief Confirm delivery of a serialized update
+     * 
+     * @param sequence Sequence returned by serializeChanges()
+     */
+    void onDelivered(uint32_t sequence);
+    
+    /**
+     * @brief Report that a serialized update was not delivered
+     * 
+     * Marks its fields dirty again, and requests a full snapshot if the
+     * update was one.
+     * 
+     * @param sequence Sequence returned by serializeChanges()
+     */
+    void onDeliveryFailed(uint32_t sequence);
+    
+    /**
+     * @brief Force the next serialization to include every field
+     */
+    void requestFullSnapshot();
+    
+    /**
+     * @brief Check if any field is dirty
+     * 
+     * @return true if at least one field changed and is not in flight
+     */
+    bool hasChanges() const;
+    
+    /**
+     * @brief Check if a split full snapshot has parts left to serialize
+     * 
+     * @return true until the last part of the snapshot was written
+     */
+    bool snapshotPending() const;
+
+private:
+    struct Field {
+        char key[MAX_NAME_LENGTH + 4];   ///< Preformatted "\"name\":"
+        uint8_t keyLength;
+        StatusFieldType type;
+        std::atomic<int64_t> value;      ///< Integer value or float bit pattern
+    };
+    
+    /**
+     * @brief Dirty bits of an update awaiting delivery
+     */
+    struct InFlightUpdate {
+        uint32_t sequence;               ///< 0 if the slot is free
+        bool full;                       ///< Whether the update was a full snapshot
+        std::unique_ptr<uint64_t[]> bits; ///< Fields written, one bit per field
+    };
+    
+    size_t mMaxFields;
+    std::unique_ptr<Field[]> mFields;
+    std::unique_ptr<std::atomic<uint64_t>[]> mDirty; ///< One bit per field
+    std::atomic<size_t> mFieldCount;
+    uint32_t mFullSnapshotInterval;
+    uint32_t mSerializations;
+    uint32_t mSequence;
+    size_t mSnapshotCursor;          ///< Next field of a split full snapshot, 0 if none is in progress
+    uint16_t mSnapshotPart;          ///< Part number of the next snapshot message
+    std::atomic<bool> mFullRequested;
+    std::array<InFlightUpdate, DeviceConfig::STATUS_MAX_IN_FLIGHT> mInFlight; ///< Slot = sequence % size
+    std::mutex mRegisterMutex;
+    
+    /**
+     * @brief Store a value and mark the field dirty if it changed
+     * 
+     * @param field Field handle
+     * @param value Raw value
+     */
+    void store(StatusFieldId field, int64_t value);
+    
+    /**
+     * @brief Merge an in-flight snapshot back into the dirty bits
+     * 
+     * Also used when serializeChanges() reuses a slot whose update was
+     * never resolved.
+     * 
+     * @param update Snapshot to restore; freed afterwards
+     */
+    void restore(InFlightUpdate& update);
+};
+
+} // namespace Communication
+
+#endif // STATUS_REGISTRY_H
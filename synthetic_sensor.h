@@ -0,0 +1,158 @@
+/**
+ * @file synthetic_sensor.h
+ * @brief Sensor producing configurable synthetic signals
+ * 
+ * This file provides a sensor implementation that generates readings
+ * from signal models instead of hardware, for load and scale testing
+ * of the acquisition, processing and communication paths.
+ */
+
+#ifndef SYNTHETIC_SENSOR_H
+#define SYNTHETIC_SENSOR_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "sensor_base.h"
+
+namespace Sensors {
+
+/**
+ * @brief Signal shapes produced by the synthetic sensor
+ */
+enum class SignalType {
+    SINE,         ///< offset + amplitude * sin(2*pi*t/period)
+    RANDOM_WALK,  ///< Previous value plus a N(0, stdDev) step, clamped to offset +/- amplitude
+    STEP,         ///< Alternates between offset and offset + amplitude every half period
+    NOISE,        ///< offset + N(0, stdDev)
+    SPIKES        ///< offset + N(0, stdDev), with spikes of amplitude at the given probability
+};
+
+/**
+ * @brief Signal model of one channel
+ */
+struct SignalConfig {
+    SignalType type;          ///< Signal shape
+    float offset;             ///< Baseline value
+    float amplitude;          ///< Sine/step amplitude, walk bound or spike height
+    uint32_t periodMs;        ///< Sine and step period
+    float stdDev;             ///< Noise and random-walk step standard deviation
+    float spikeProbability;   ///< Probability of a spike per reading (SPIKES)
+    
+    SignalConfig()
+        : type(SignalType::SINE), offset(0.0f), amplitude(1.0f), periodMs(60000),
+          stdDev(0.1f), spikeProbability(0.01f) {}
+    
+    SignalConfig(SignalType t, float off, float amp, uint32_t period = 60000,
+                 float sd = 0.1f, float spikeProb = 0.01f)
+        : type(t), offset(off), amplitude(amp), periodMs(period),
+          stdDev(sd), spikeProbability(spikeProb) {}
+};
+
+/**
+ * @brief Synthetic sensor class
+ * 
+ * read() never blocks; values are computed from the reading timestamp,
+ * so output is deterministic for a given seed and read schedule.
+ */
+class SyntheticSensor : public SensorBase {
+public:
+    /**
+     * @brief Constructor for synthetic sensor
+     * 
+     * @param id Unique sensor identifier
+     * @param name Human-readable name of the sensor
+     * @param channels Signal model per channel
+     * @param unit Unit reported in readings
+     * @param seed Random seed
+     */
+    SyntheticSensor(SensorId id,
+                    const std::string& name,
+                    const std::vector<SignalConfig>& channels,
+                    const std::string& unit = "",
+                    uint32_t seed = 1);
+    
+    /**
+     * @brief Destructor
+     */
+    virtual ~SyntheticSensor();
+    
+    /**
+     * @brief Initialize the synthetic sensor
+     * 
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize() override;
+    
+    /**
+     * @brief Generate a reading
+     * 
+     * Values are treated as raw; read() applies any calibration set.
+     * 
+     * @return SensorReading object containing one value per channel
+     */
+    SensorReading readRaw() override;
+    
+    /**
+     * @brief Synthetic sensors need no calibration
+     * 
+     * @return true
+     */
+    bool calibrate() override;
+    
+    /**
+     * @brief Put the sensor in low-power mode
+     * 
+     * @return true
+     */
+    bool sleep() override;
+    
+    /**
+     * @brief Wake up the sensor
+     * 
+     * @return true
+     */
+    bool wakeUp() override;
+    
+    /**
+     * @brief Self-test the sensor
+     * 
+     * @return true if at least one channel is configured, false otherwise
+     */
+    bool selfTest() override;
+    
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * @return Empty, synthetic sensors share no bus
+     */
+    std::string getBusKey() const override;
+    
+    /**
+     * @brief Make read() fail with the given probability
+     * 
+     * @param probability Failure probability per reading
+     */
+    void setFailureRate(float probability);
+
+private:
+    std::vector<SignalConfig> mChannels;
+    std::vector<float> mWalkState;     ///< Current random-walk value per channel
+    std::string mUnit;
+    std::mt19937 mRandom;
+    float mFailureRate;
+    
+    /**
+     * @brief Compute one channel value
+     * 
+     * @param channel Channel index
+     * @param timestampMs Reading timestamp
+     * @return Channel value
+     */
+    float generate(size_t channel, uint64_t timestampMs);
+};
+
+} // namespace Sensors
+
+#endif // SYNTHETIC_SENSOR_H
@@ -0,0 +1,186 @@
+/**
+ * @file timeseries_query.h
+ * @brief Range queries and downsampling over stored readings
+ * 
+ * This file provides a query engine over the time-series store that
+ * returns raw readings or downsampled series for a sensor and time
+ * range, decoding only the chunks the sparse index selects.
+ */
+
+#ifndef TIMESERIES_QUERY_H
+#define TIMESERIES_QUERY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "timeseries_store.h"
+
+namespace Storage {
+
+/**
+ * @brief Downsampling methods
+ */
+enum class DownsampleMethod {
+    NONE,      ///< Raw readings
+    BUCKET,    ///< Min/max/avg per fixed time bucket
+    LTTB       ///< Largest-Triangle-Three-Buckets on one channel
+};
+
+/**
+ * @brief Query parameters
+ */
+struct QueryRequest {
+    Sensors::SensorId sensorId; ///< Sensor identifier
+    uint64_t from;             ///< Start of the range (ms, inclusive)
+    uint64_t to;               ///< End of the range (ms, inclusive)
+    DownsampleMethod method;   ///< Downsampling method
+    uint32_t bucketMs;         ///< Bucket width for BUCKET
+    uint32_t maxPoints;        ///< Output points for LTTB, and a cap for NONE
+    uint8_t channel;           ///< Channel LTTB selects points on
+    
+    QueryRequest()
+        : sensorId(0), from(0), to(0), method(DownsampleMethod::NONE),
+          bucketMs(60000), maxPoints(DeviceConfig::HISTORY_MAX_POINTS), channel(0) {}
+};
+
+/**
+ * @brief Aggregate of one time bucket
+ * 
+ * min, max and avg hold one value per channel.
+ */
+struct BucketAggregate {
+    uint64_t timestamp;        ///< Start of the bucket (ms)
+    uint32_t count;            ///< Readings in the bucket
+    std::vector<float> min;    ///< Minimum per channel
+    std::vector<float> max;    ///< Maximum per channel
+    std::vector<float> avg;    ///< Average per channel
+    
+    BucketAggregate() : timestamp(0), count(0), min(), max(), avg() {}
+};
+
+/**
+ * @brief Query result
+ */
+struct QueryResult {
+    std::vector<Sensors::SensorReading> readings;  ///< Raw or LTTB-selected readings
+    std::vector<BucketAggregate> buckets;          ///< Buckets for BUCKET
+    uint32_t chunksDecoded;                        ///< Chunks decoded to answer the query
+    bool truncated;                                ///< Whether maxPoints cut the result short
+    
+    QueryResult() : readings(), buckets(), chunksDecoded(0), truncated(false) {}
+};
+
+/**
+ * @brief Time-series query engine class
+ */
+class TimeSeriesQuery {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param store Store to query
+     */
+    explicit TimeSeriesQuery(TimeSeriesStore& store);
+    
+    /**
+     * @brief Destructor
+     */
+    ~TimeSeriesQuery();
+    
+    /**
+     * @brief Run a query
+     * 
+     * BUCKET aggregates while decoding, so memory stays proportional to
+     * the number of buckets rather than the number of readings. A BUCKET
+     * request with bucketMs below HISTORY_MIN_BUCKET_MS, or whose range
+     * spans more than HISTORY_MAX_POINTS buckets, fails before any bucket
+     * is allocated (see isValidBucketing()). LTTB
+     * holds at most HISTORY_LTTB_MAX_INPUT readings: when the index
+     * counts more in the range, only every n-th reading is kept while
+     * decoding, so the selection runs on an evenly thinned input.
+     * 
+     * @param request Query parameters
+     * @param result Reference to store the result
+     * @return true if successful, false otherwise
+     */
+    bool execute(const QueryRequest& request, QueryResult& result);
+    
+    /**
+     * @brief Parse a history command payload
+     * 
+     * Expects a JSON object such as
+     * {"sensor":3,"from":1700000000000,"to":1700003600000,"method":"lttb","points":200}
+     * where "method" is "raw", "bucket" or "lttb" and "bucket" gives the
+     * bucket width in ms. Fails for bucket requests that
+     * isValidBucketing() rejects.
+     * 
+     * @param payload Command payload
+     * @param request Reference to store the parsed request
+     * @return true if the payload is valid, false otherwise
+     */
+    static bool parseRequest(std::string_view payload, QueryRequest& request);
+    
+    /**
+     * @brief Check that a BUCKET request has a bounded number of buckets
+     * 
+     * @param request Query parameters
+     * @return true if the request is not BUCKET, or its bucket width is at
+     *         least HISTORY_MIN_BUCKET_MS and the range spans at most
+     *         HISTORY_MAX_POINTS buckets
+     */
+    static bool isValidBucketing(const QueryRequest& request) {
+        if (request.method != DownsampleMethod::BUCKET) {
+            return true;
+        }
+        if (request.bucketMs < DeviceConfig::HISTORY_MIN_BUCKET_MS || request.to < request.from) {
+            return false;
+        }
+        return (request.to - request.from) / request.bucketMs < DeviceConfig::HISTORY_MAX_POINTS;
+    }
+    
+    /**
+     * @brief Serialize a result as JSON
+     * 
+     * @param request Request the result answers
+     * @param result Query result
+     * @param out String to append to
+     */
+    static void serializeResult(const QueryRequest& request, const QueryResult& result, std::string& out);
+    
+    /**
+     * @brief Downsample readings with Largest-Triangle-Three-Buckets
+     * 
+     * Keeps the first and last reading and, from each of the
+     * threshold - 2 buckets in between, the reading forming the largest
+     * triangle with the previously selected point and the next bucket's
+     * average.
+     * 
+     * @param input Readings in time order
+     * @param channel Channel to evaluate
+     * @param threshold Number of output points
+     * @param output Vector to store the selected readings
+     */
+    static void lttb(const std::vector<Sensors::SensorReading>& input, uint8_t channel,
+                     size_t threshold, std::vector<Sensors::SensorReading>& output);
+
+private:
+    TimeSeriesStore& mStore;
+    
+    /**
+     * @brief Count the readings in the requested range from the chunk index
+     * 
+     * Sums ChunkIndexEntry::count over the chunks overlapping the range
+     * without decoding them; partially covered chunks count in full.
+     * 
+     * @param request Query parameters
+     * @return Upper bound of the readings in the range
+     */
+    uint64_t countReadings(const QueryRequest& request) const;
+};
+
+} // namespace Storage
+
+#endif // TIMESERIES_QUERY_H
@@ -0,0 +1,396 @@
+/**
+ * @file timeseries_store.h
+ * @brief Embedded time-series store for sensor readings
+ * 
+ * This file provides an on-device store that persists readings at full
+ * rate under LOCAL_STORAGE_PATH. Readings are compressed in memory into
+ * per-sensor chunks (delta-of-delta timestamps, XOR-encoded floats) and
+ * each sealed chunk is written once, sequentially, to an append-only
+ * segment file, which keeps write amplification on SD cards low.
+ * 
+ * All sensors share the segment files; each chunk header and index
+ * entry carries the sensor ID, so the store holds two file descriptors
+ * however many sensors there are. On-disk layout:
+ * 
+ *   <LOCAL_STORAGE_PATH>/ts/<firstTimestamp>.seg   chunks
+ *   <LOCAL_STORAGE_PATH>/ts/<firstTimestamp>.idx   ChunkIndexEntry records
+ */
+
+#ifndef TIMESERIES_STORE_H
+#define TIMESERIES_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "../system/error_handler.h"
+
+namespace Storage {
+
+/**
+ * @brief Header written in front of every chunk
+ */
+struct ChunkHeader {
+    static constexpr uint32_t MAGIC = 0x4B484354; // "TCHK"
+    
+    static constexpr uint8_t FORMAT_VERSION = 3;
+    
+    uint32_t magic;          ///< MAGIC
+    uint8_t version;         ///< FORMAT_VERSION
+    uint8_t channelCount;    ///< Values per reading
+    uint16_t flags;          ///< Reserved
+    uint32_t sensorId;       ///< Sensor identifier
+    uint64_t firstTimestamp; ///< Timestamp of the first reading (ms)
+    uint64_t lastTimestamp;  ///< Timestamp of the last reading (ms)
+    uint32_t count;          ///< Number of readings
+    uint32_t dataLength;     ///< Compressed data length following the header
+    uint32_t crc32;          ///< CRC-32 of the compressed data
+};
+
+/**
+ * @brief Sparse index entry, one per chunk
+ */
+struct ChunkIndexEntry {
+    uint64_t firstTimestamp; ///< Timestamp of the first reading (ms)
+    uint64_t lastTimestamp;  ///< Timestamp of the last reading (ms)
+    uint64_t offset;         ///< Offset of the ChunkHeader in the segment file
+    uint32_t length;         ///< Header plus data length
+    uint32_t count;          ///< Number of readings
+    uint32_t sensorId;       ///< Sensor identifier, as in the ChunkHeader
+    uint32_t reserved;       ///< Padding, zero
+};
+
+/**
+ * @brief Read-only view of a stored chunk
+ * 
+ * Points into a memory-mapped segment and is valid only inside the
+ * callback it was passed to.
+ */
+struct ChunkView {
+    const ChunkHeader* header; ///< Chunk header
+    const uint8_t* data;       ///< Compressed data
+};
+
+/**
+ * @brief Compressor for one chunk of readings
+ * 
+ * Timestamps are stored as delta-of-delta with variable-length buckets
+ * and each channel as the XOR with its previous value (Gorilla
+ * encoding), so slowly changing signals cost a few bits per value.
+ */
+class ChunkEncoder {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * The buffer grows on demand up to maxBytes, so sensors with small
+     * or slow chunks do not each hold a full-size buffer.
+     * 
+     * @param maxBytes Capacity of the compressed buffer
+     */
+    explicit ChunkEncoder(size_t maxBytes = DeviceConfig::TS_CHUNK_MAX_BYTES);
+    
+    /**
+     * @brief Start a new chunk
+     * 
+     * @param sensorId Sensor identifier
+     * @param channelCount Values per reading
+     */
+    void reset(Sensors::SensorId sensorId, uint8_t channelCount);
+    
+    /**
+     * @brief Append a reading
+     * 
+     * @param timestamp Timestamp in milliseconds, not older than the last one
+     * @param values Channel values, channelCount of them
+     * @return false if the chunk is full and must be sealed first
+     */
+    bool append(uint64_t timestamp, const float* values);
+    
+    /**
+     * @brief Fill in the header of the chunk built so far
+     * 
+     * @param header Header to fill
+     */
+    void finish(ChunkHeader& header) const;
+    
+    /**
+     * @brief Get the compressed data
+     * 
+     * @return Pointer to the compressed data
+     */
+    const uint8_t* data() const;
+    
+    /**
+     * @brief Get the compressed data length in bytes
+     * 
+     * @return Compressed length
+     */
+    size_t size() const;
+    
+    /**
+     * @brief Get the number of readings in the chunk
+     * 
+     * @return Reading count
+     */
+    uint32_t count() const;
+    
+    /**
+     * @brief Get the timestamp of the first reading
+     * 
+     * @return First timestamp in milliseconds
+     */
+    uint64_t firstTimestamp() const;
+
+private:
+    std::vector<uint8_t> mBuffer;
+    size_t mMaxBytes;
+    size_t mBitPosition;
+    Sensors::SensorId mSensorId;
+    uint8_t mChannelCount;
+    uint32_t mCount;
+    uint64_t mFirstTimestamp;
+    uint64_t mLastTimestamp;
+    int64_t mLastDelta;
+    std::vector<uint32_t> mLastValues;
+    std::vector<uint8_t> mLastLeadingZeros;
+    std::vector<uint8_t> mLastTrailingZeros;
+    
+    /**
+     * @brief Write bits to the buffer
+     * 
+     * @param value Bits to write, right-aligned
+     * @param bits Number of bits
+     * @return false if the buffer has reached mMaxBytes
+     */
+    bool writeBits(uint64_t value, uint8_t bits);
+};
+
+/**
+ * @brief Decompressor for one chunk
+ */
+class ChunkDecoder {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param view Chunk to decode
+     */
+    explicit ChunkDecoder(const ChunkView& view);
+    
+    /**
+     * @brief Decode the next reading
+     * 
+     * @param timestamp Reference to store the timestamp
+     * @param values Buffer of channelCount floats to store the values
+     * @return false when the chunk is exhausted or corrupt
+     */
+    bool next(uint64_t& timestamp, float* values);
+
+private:
+    ChunkView mView;
+    size_t mBitPosition;
+    uint32_t mRemaining;
+    uint64_t mLastTimestamp;
+    int64_t mLastDelta;
+    std::vector<uint32_t> mLastValues;
+    std::vector<uint8_t> mLastLeadingZeros;
+    std::vector<uint8_t> mLastTrailingZeros;
+};
+
+/**
+ * @brief Store statistics
+ */
+struct TimeSeriesStats {
+    uint64_t readingsWritten;   ///< Readings accepted by append()
+    uint64_t chunksWritten;     ///< Chunks sealed and written
+    uint64_t bytesWritten;      ///< Bytes written to segment and index files
+    uint64_t rawBytes;          ///< Uncompressed size of the written readings
+    uint64_t segmentsDeleted;   ///< Segments removed by retention
+    uint64_t diskUsage;         ///< Current size of all segments
+    
+    TimeSeriesStats()
+        : readingsWritten(0), chunksWritten(0), bytesWritten(0),
+          rawBytes(0), segmentsDeleted(0), diskUsage(0) {}
+};
+
+/**
+ * @brief Chunk visitor callback type
+ * 
+ * Return false to stop the iteration.
+ */
+using ChunkVisitor = std::function<bool(const ChunkView&)>;
+
+/**
+ * @brief Time-series store class
+ */
+class TimeSeriesStore {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param basePath Root directory of the store
+     */
+    explicit TimeSeriesStore(const std::string& basePath = DeviceConfig::LOCAL_STORAGE_PATH);
+    
+    /**
+     * @brief Destructor, seals and writes open chunks
+     */
+    ~TimeSeriesStore();
+    
+    /**
+     * @brief Open the store and load the sparse indexes
+     * 
+     * Index entries are assigned to their series by sensorId. Truncates
+     * a torn chunk at the tail of a segment left by a crash.
+     * 
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize();
+    
+    /**
+     * @brief Append a reading
+     * 
+     * Only touches the sensor's in-memory chunk; disk I/O happens when a
+     * chunk is sealed (TS_CHUNK_MAX_POINTS readings, TS_CHUNK_MAX_SPAN_MS
+     * of data or a full buffer). Invalid readings are skipped.
+     * 
+     * @param reading Reading to store
+     * @return true if stored, false otherwise
+     */
+    bool append(const Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Seal and write all open chunks
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool flush();
+    
+    /**
+     * @brief Visit stored chunks overlapping a time range
+     * 
+     * Uses the sparse index to locate chunks and reads them through a
+     * read-only memory mapping of the segment. The sensor's open
+     * in-memory chunk is visited last.
+     * 
+     * @param sensorId Sensor identifier
+     * @param from Start of the range (ms, inclusive)
+     * @param to End of the range (ms, inclusive)
+     * @param visitor Callback for each chunk, in time order
+     * @return true if successful, false otherwise
+     */
+    bool visitChunks(Sensors::SensorId sensorId, uint64_t from, uint64_t to, const ChunkVisitor& visitor);
+    
+    /**
+     * @brief Delete the oldest segments beyond the size or age limit
+     * 
+     * Segments are shared, so their chunks are dropped from every series.
+     * 
+     * @param nowMs Current time in milliseconds
+     * @return Number of segments deleted
+     */
+    size_t enforceRetention(uint64_t nowMs);
+    
+    /**
+     * @brief Get the time range stored for a sensor
+     * 
+     * @param sensorId Sensor identifier
+     * @param first Reference to store the first timestamp
+     * @param last Reference to store the last timestamp
+     * @return false if nothing is stored for the sensor
+     */
+    bool getTimeRange(Sensors::SensorId sensorId, uint64_t& first, uint64_t& last) const;
+    
+    /**
+     * @brief Get store statistics
+     * 
+     * @return Store statistics
+     */
+    TimeSeriesStats getStats() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    /**
+     * @brief Shared segment file
+     */
+    struct Segment {
+        std::string path;                    ///< Segment file path
+        uint32_t number;                     ///< Sequence number, increasing from the oldest
+        uint64_t firstTimestamp;             ///< First timestamp in the segment
+        uint64_t size;                       ///< Segment size in bytes
+    };
+    
+    /**
+     * @brief Location of a sealed chunk
+     */
+    struct ChunkLocation {
+        uint32_t segment;          ///< Segment::number of the segment holding the chunk
+        ChunkIndexEntry entry;     ///< Index entry of the chunk
+    };
+    
+    /**
+     * @brief Per-sensor series state
+     */
+    struct Series {
+        ChunkEncoder encoder;               ///< Open chunk
+        std::vector<ChunkLocation> chunks;  ///< Sealed chunks, oldest first
+        std::mutex mutex;                   ///< Guards the series
+        
+        Series() : encoder(), chunks(), mutex() {}
+    };
+    
+    std::string mBasePath;
+    std::map<Sensors::SensorId, std::unique_ptr<Series>> mSeries;
+    std::vector<Segment> mSegments;         ///< Shared segments, oldest first
+    int mSegmentFd;                         ///< Active segment file
+    int mIndexFd;                           ///< Active index file
+    std::mutex mWriteMutex;                 ///< Guards mSegments and the active files
+    TimeSeriesStats mStats;
+    System::ErrorCode mLastError;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Get or create the series for a sensor
+     * 
+     * @param sensorId Sensor identifier
+     * @return Series
+     */
+    Series& series(Sensors::SensorId sensorId);
+    
+    /**
+     * @brief Write the open chunk of a series and start a new one
+     * 
+     * Header and data go out in one writev to the shared active segment
+     * under mWriteMutex; a new segment is started once the active one
+     * exceeds TS_SEGMENT_SIZE_KB.
+     * 
+     * @param sensorId Sensor identifier
+     * @param series Series to seal
+     * @return true if successful, false otherwise
+     */
+    bool sealChunk(Sensors::SensorId sensorId, Series& series);
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Storage
+
+#endif // TIMESERIES_STORE_H
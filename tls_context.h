@@ -0,0 +1,251 @@
+/**
+ * @file tls_context.h
+ * @brief Shared TLS context with certificate and session caching
+ * 
+ * This file provides a TLS context that parses the CA, client
+ * certificate and private key once, keeps them in memory, and
+ * caches session tickets so reconnects can use an abbreviated
+ * handshake instead of a full one.
+ */
+
+#ifndef TLS_CONTEXT_H
+#define TLS_CONTEXT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+#include "../config.h"
+#include "../system/error_handler.h"
+
+// Forward declaration for the TLS library context
+// In a real implementation, this would be a concrete type
+// from a library like OpenSSL, mbedTLS or wolfSSL
+struct ssl_ctx;
+
+namespace Communication {
+
+/**
+ * @brief Cipher suite preference for TLS connections
+ */
+enum class TLSCipherPreference {
+    AUTO,              ///< ChaCha20 first on cores without hardware AES, AES-GCM otherwise
+    AES_GCM,           ///< Prefer AES-GCM suites
+    CHACHA20_POLY1305  ///< Prefer ChaCha20-Poly1305 suites
+};
+
+/**
+ * @brief Cached TLS session for resumption
+ */
+struct TLSSession {
+    std::vector<uint8_t> ticket;  ///< Serialized session ticket / PSK identity
+    uint64_t expiresAt;           ///< Expiry time in milliseconds since epoch
+    
+    TLSSession() : ticket(), expiresAt(0) {}
+};
+
+/**
+ * @brief Handshake statistics
+ */
+struct TLSHandshakeStats {
+    uint32_t fullHandshakes;     ///< Number of full handshakes performed
+    uint32_t resumedHandshakes;  ///< Number of abbreviated (resumed) handshakes
+    uint64_t totalFullUs;        ///< Accumulated wall time of full handshakes in microseconds
+    uint64_t totalResumedUs;     ///< Accumulated wall time of resumed handshakes in microseconds
+    uint64_t totalCpuUs;         ///< Accumulated CPU time spent in handshakes in microseconds
+    
+    TLSHandshakeStats()
+        : fullHandshakes(0), resumedHandshakes(0),
+          totalFullUs(0), totalResumedUs(0), totalCpuUs(0) {}
+};
+
+/**
+ * @brief TLS context class
+ * 
+ * A single context is shared by all connections of the device, so
+ * certificate parsing happens once per process rather than once per
+ * connect.
+ */
+class TLSContext {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param caCert CA certificate file path
+     * @param clientCert Client certificate file path (optional)
+     * @param privateKey Private key file path (optional)
+     */
+    TLSContext(
+        const std::string& caCert,
+        const std::string& clientCert = "",
+        const std::string& privateKey = ""
+    );
+    
+    /**
+     * @brief Destructor
+     */
+    ~TLSContext();
+    
+    /**
+     * @brief Load and parse certificates into the in-memory context
+     * 
+     * @return true if initialization successful, false otherwise
+     */
+    bool initialize();
+    
+    /**
+     * @brief Re-read certificates from disk, e.g. after rotation
+     * 
+     * Cached sessions are invalidated since they were issued
+     * for the previous client identity.
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool reloadCertificates();
+    
+    /**
+     * @brief Set the cipher suite preference
+     * 
+     * @param preference Cipher preference
+     */
+    void setCipherPreference(TLSCipherPreference preference);
+    
+    /**
+     * @brief Get the resolved cipher suite list in preference order
+     * 
+     * @return Colon-separated list of cipher suites
+     */
+    std::string getCipherList() const;
+    
+    /**
+     * @brief Enable or disable session resumption
+     * 
+     * @param enabled Whether session tickets/PSK resumption is used
+     */
+    void setSessionResumption(bool enabled);
+    
+    /**
+     * @brief Check if session resumption is enabled
+     * 
+     * @return true if enabled, false otherwise
+     */
+    bool isSessionResumptionEnabled() const;
+    
+    /**
+     * @brief Store a session ticket received from a server
+     * 
+     * @param host Server host name
+     * @param port Server port
+     * @param session Session to cache
+     */
+    void storeSession(const std::string& host, uint16_t port, const TLSSession& session);
+    
+    /**
+     * @brief Look up a cached, unexpired session for a server
+     * 
+     * @param host Server host name
+     * @param port Server port
+     * @param session Reference to store the cached session
+     * @return true if a usable session was found, false otherwise
+     */
+    bool findSession(const std::string& host, uint16_t port, TLSSession& session) const;
+    
+    /**
+     * @brief Drop the cached session for a server
+     * 
+     * Called when the server rejects resumption so the next
+     * connect falls back to a full handshake.
+     * 
+     * @param host Server host name
+     * @param port Server port
+     */
+    void invalidateSession(const std::string& host, uint16_t port);
+    
+    /**
+     * @brief Persist cached sessions so they survive a restart
+     * 
+     * Tickets and resumption PSKs are secrets, so the file is sealed with
+     * AES-256-GCM under the device key, with the path as associated data,
+     * and written with mode 0600 through a temporary file and rename.
+     * 
+     * @param path File path to write to
+     * @param deviceKey 32-byte device key, e.g. from TLS_SESSION_KEY_PATH
+     * @return false if the key is not 32 bytes or writing fails
+     */
+    bool saveSessions(const std::string& path, const std::vector<uint8_t>& deviceKey) const;
+    
+    /**
+     * @brief Load cached sessions persisted by saveSessions()
+     * 
+     * A file that fails authentication, e.g. from another device or after
+     * a key change, is deleted and no session is loaded.
+     * 
+     * @param path File path to read from
+     * @param deviceKey Device key the file was sealed with
+     * @return true if successful, false otherwise
+     */
+    bool loadSessions(const std::string& path, const std::vector<uint8_t>& deviceKey);
+    
+    /**
+     * @brief Record the cost of a completed handshake
+     * 
+     * @param resumed Whether the handshake was abbreviated
+     * @param wallUs Wall time of the handshake in microseconds
+     * @param cpuUs CPU time of the handshake in microseconds
+     */
+    void recordHandshake(bool resumed, uint64_t wallUs, uint64_t cpuUs);
+    
+    /**
+     * @brief Get handshake statistics
+     * 
+     * @return Handshake statistics
+     */
+    TLSHandshakeStats getHandshakeStats() const;
+    
+    /**
+     * @brief Get the underlying library context
+     * 
+     * @return Native TLS context pointer
+     */
+    ssl_ctx* getNativeContext() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    std::string mCaCert;
+    std::string mClientCert;
+    std::string mPrivateKey;
+    ssl_ctx* mContext;
+    TLSCipherPreference mCipherPreference;
+    bool mSessionResumption;
+    std::map<std::string, TLSSession> mSessions;  ///< Cached sessions keyed by "host:port"
+    TLSHandshakeStats mStats;
+    System::ErrorCode mLastError;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Build the session cache key for a server
+     * 
+     * @param host Server host name
+     * @param port Server port
+     * @return Cache key
+     */
+    static std::string sessionKey(const std::string& host, uint16_t port);
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Communication
+
+#endif // TLS_CONTEXT_H
@@ -0,0 +1,236 @@
+/**
+ * @file trace_recorder.h
+ * @brief Compact recording of sensor reading streams
+ * 
+ * This file provides a recorder that captures SensorReading streams on
+ * a device together with their original timing, and a reader that
+ * plays the recording back for replay and throughput testing.
+ * 
+ * File layout:
+ * 
+ *   | magic "SRTR" (4) | version (1) | start timestamp (8, LE) | records... |
+ * 
+ * Record layout:
+ * 
+ *   | timestamp delta (zigzag varint, ms) | sensorId (varint) | flags (1) | channels (1) |
+ *   | [unit length (1) | unit] | values (channels x float32, LE) |
+ * 
+ * The timestamp delta is signed, because readings from several threads
+ * or across an NTP step can arrive out of order; zigzag maps it to an
+ * unsigned varint so small negative deltas stay small.
+ * 
+ * Flags bit 0 is the valid flag; bit 1 marks that the unit follows,
+ * which is only written when a sensor's unit changes.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "../system/error_handler.h"
+
+namespace Storage {
+
+/**
+ * @brief Recorder statistics
+ */
+struct TraceRecorderStats {
+    uint64_t records;       ///< Records written
+    uint64_t bytes;         ///< Bytes written including the file header
+    uint64_t dropped;       ///< Records dropped because the size limit was reached
+    
+    TraceRecorderStats() : records(0), bytes(0), dropped(0) {}
+};
+
+/**
+ * @brief Trace recorder class
+ */
+class TraceRecorder {
+public:
+    static constexpr uint8_t FORMAT_VERSION = 3;
+    
+    /**
+     * @brief Constructor
+     * 
+     * @param maxSizeKB Recording stops once the file reaches this size
+     */
+    explicit TraceRecorder(uint32_t maxSizeKB = DeviceConfig::TRACE_RECORD_MAX_SIZE_KB);
+    
+    /**
+     * @brief Destructor, closes the recording
+     */
+    ~TraceRecorder();
+    
+    /**
+     * @brief Start a recording
+     * 
+     * @param path File path, truncated if it exists
+     * @return true if successful, false otherwise
+     */
+    bool open(const std::string& path);
+    
+    /**
+     * @brief Append readings to the recording
+     * 
+     * Records are buffered and written in blocks, so this can be called
+     * from the acquisition path.
+     * 
+     * @param readings Readings to record
+     * @return true if recorded, false if closed or the size limit was reached
+     */
+    bool record(const std::vector<Sensors::SensorReading>& readings);
+    
+    /**
+     * @brief Flush buffered records and close the recording
+     */
+    void close();
+    
+    /**
+     * @brief Check if a recording is open
+     * 
+     * @return true if open, false otherwise
+     */
+    bool isOpen() const;
+    
+    /**
+     * @brief Get recorder statistics
+     * 
+     * @return Statistics
+     */
+    TraceRecorderStats getStats() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    FILE* mFile;
+    uint64_t mMaxBytes;
+    uint64_t mLastTimestamp;
+    std::vector<uint8_t> mBuffer;           ///< Pending encoded records
+    std::unordered_map<Sensors::SensorId, std::string> mUnits; ///< Last unit written per sensor
+    TraceRecorderStats mStats;
+    System::ErrorCode mLastError;
+    mutable std::mutex mMutex;
+    
+    /**
+     * @brief Encode one reading into mBuffer
+     * 
+     * @param reading Reading to encode
+     */
+    void encode(const Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Zigzag-encode a signed value for an unsigned varint
+     * 
+     * @param value Signed value
+     * @return Unsigned value, 0, -1, 1, -2 ... map to 0, 1, 2, 3 ...
+     */
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+    
+    /**
+     * @brief Write mBuffer to the file
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool flushBuffer();
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+/**
+ * @brief Trace reader class
+ */
+class TraceReader {
+public:
+    /**
+     * @brief Constructor
+     */
+    TraceReader();
+    
+    /**
+     * @brief Destructor
+     */
+    ~TraceReader();
+    
+    /**
+     * @brief Open a recording
+     * 
+     * @param path File path
+     * @return true if the header is valid and has TraceRecorder::FORMAT_VERSION,
+     *         false otherwise
+     */
+    bool open(const std::string& path);
+    
+    /**
+     * @brief Read the next record
+     * 
+     * @param reading Reference to store the reading, with its original timestamp
+     * @return true if a record was read, false at the end or on a corrupt record
+     */
+    bool next(Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Restart from the first record
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool rewind();
+    
+    /**
+     * @brief Get the timestamp of the first record
+     * 
+     * @return Start timestamp in milliseconds since epoch
+     */
+    uint64_t getStartTimestamp() const;
+    
+    /**
+     * @brief Close the recording
+     */
+    void close();
+
+private:
+    FILE* mFile;
+    uint64_t mStartTimestamp;
+    uint64_t mLastTimestamp;
+    std::unordered_map<Sensors::SensorId, std::string> mUnits; ///< Current unit per sensor
+    
+    /**
+     * @brief Read an unsigned LEB128 varint
+     * 
+     * @param value Reference to store the value
+     * @return true if successful, false otherwise
+     */
+    bool readVarint(uint64_t& value);
+    
+    /**
+     * @brief Decode a zigzag-encoded signed value
+     * 
+     * @param value Unsigned varint value
+     * @return Signed value
+     */
+    static int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+};
+
+} // namespace Storage
+
+#endif // TRACE_RECORDER_H
@@ -47,7 +47,7 @@ public:
      * @param stopBits Stop bits setting
      * @param dataBits Data bits (5-8)
      */
-    UARTSensor(uint8_t id, 
+    UARTSensor(SensorId id, 
                const std::string& name,
                const std::string& port,
                speed_t baudRate = B9600,
@@ -68,11 +68,11 @@ public:
     bool initialize() override;
     
     /**
-     * @brief Read data from the UART sensor
+     * @brief Read raw data from the UART sensor
      * 
-     * @return SensorReading object containing the measured values
+     * @return SensorReading object containing the uncalibrated values
      */
-    SensorReading read() override;
+    SensorReading readRaw() override;
     
     /**
      * @brief Calibrate the UART sensor
@@ -102,6 +102,13 @@ public:
      */
     bool selfTest() override;
     
+    /**
+     * @brief Get the key of the bus the sensor is attached to
+     * 
+     * @return the UART port name
+     */
+    std::string getBusKey() const override;
+    
     /**
      * @brief Send data over UART
      * 
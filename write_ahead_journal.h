@@ -0,0 +1,319 @@
+/**
+ * @file write_ahead_journal.h
+ * @brief Crash-safe journal for acquired readings
+ * 
+ * This file provides a write-ahead journal that makes acquired readings
+ * durable within a bounded window using group commit, and replays the
+ * unacknowledged tail on startup.
+ * 
+ * Every segment starts with a JournalSegmentHeader, followed by records
+ * (little endian):
+ * 
+ *   | length (2) | type (1) | crc32 (4) | lsn (8) | payload (length) |
+ * 
+ * The CRC covers type, lsn and payload. Recovery stops at the first
+ * record whose CRC does not match, which is where a crash tore the write,
+ * and at the first record whose LSN is not greater than the previous
+ * one, which is where the new generation of a recycled segment ends and
+ * records of its previous generation begin.
+ */
+
+#ifndef WRITE_AHEAD_JOURNAL_H
+#define WRITE_AHEAD_JOURNAL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../sensors/sensor_base.h"
+#include "../system/error_handler.h"
+
+namespace Storage {
+
+/**
+ * @brief Journal record types
+ */
+enum class JournalRecordType : uint8_t {
+    READING = 1,      ///< Encoded SensorReading
+    CHECKPOINT = 2    ///< All records up to the LSN in the payload are acknowledged
+};
+
+/**
+ * @brief Header at the start of every segment file
+ * 
+ * Rewritten each time a segment is recycled. Recovery orders segments
+ * by generation, not by file index, and ignores records with an LSN
+ * below firstLsn.
+ */
+struct JournalSegmentHeader {
+    static constexpr uint32_t MAGIC = 0x4C4A5757; // "WWJL"
+    
+    uint32_t magic;          ///< MAGIC
+    uint32_t generation;     ///< Incremented each time any segment is (re)started
+    uint64_t firstLsn;       ///< LSN of the first record written in this generation
+    uint32_t crc32;          ///< CRC of the preceding fields
+    
+    JournalSegmentHeader() : magic(MAGIC), generation(0), firstLsn(0), crc32(0) {}
+};
+
+/**
+ * @brief Journal sync policy
+ */
+struct JournalSyncPolicy {
+    uint32_t intervalMs;   ///< Maximum time a record stays unsynced
+    uint32_t bytes;        ///< Sync early once this many bytes are pending
+    bool syncOnCritical;   ///< Sync immediately for appendDurable()
+    
+    JournalSyncPolicy()
+        : intervalMs(DeviceConfig::JOURNAL_SYNC_INTERVAL_MS),
+          bytes(DeviceConfig::JOURNAL_SYNC_BYTES),
+          syncOnCritical(true) {}
+};
+
+/**
+ * @brief Journal statistics
+ */
+struct JournalStats {
+    uint64_t appended;        ///< Records appended
+    uint64_t syncs;           ///< fdatasync calls
+    uint64_t bytesWritten;    ///< Bytes written
+    uint64_t replayed;        ///< Records replayed by the last recovery
+    uint64_t maxSyncUs;       ///< Slowest sync in microseconds
+    uint64_t durableLsn;      ///< Highest LSN known to be on disk
+    uint64_t acknowledgedLsn; ///< Highest LSN below which every record is completed
+    uint64_t untracked;       ///< Completions past the window, replayed again after a crash
+    
+    JournalStats()
+        : appended(0), syncs(0), bytesWritten(0), replayed(0),
+          maxSyncUs(0), durableLsn(0), acknowledgedLsn(0), untracked(0) {}
+};
+
+/**
+ * @brief Replay callback type
+ * 
+ * Called with the LSN and the reading of every unacknowledged record.
+ */
+using JournalReplayCallback = std::function<void(uint64_t, const Sensors::SensorReading&)>;
+
+/**
+ * @brief Write-ahead journal class
+ * 
+ * Appends only copy the encoded record into a memory buffer; a commit
+ * thread writes and syncs the buffer once per sync interval or byte
+ * threshold, so one fdatasync covers many readings. Segment files of
+ * JOURNAL_SEGMENT_SIZE_KB are preallocated and recycled once every
+ * record in them is acknowledged, which avoids file system metadata
+ * updates on the SD card.
+ */
+class WriteAheadJournal {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param directory Journal directory
+     * @param policy Sync policy
+     */
+    WriteAheadJournal(
+        const std::string& directory = DeviceConfig::JOURNAL_PATH,
+        const JournalSyncPolicy& policy = JournalSyncPolicy()
+    );
+    
+    /**
+     * @brief Destructor, syncs and closes the journal
+     */
+    ~WriteAheadJournal();
+    
+    /**
+     * @brief Open the journal and replay unacknowledged records
+     * 
+     * Orders segments by header generation and scans only those after
+     * the last checkpoint.
+     * 
+     * @param replay Callback for each unacknowledged reading
+     * @return true if successful, false otherwise
+     */
+    bool recover(const JournalReplayCallback& replay);
+    
+    /**
+     * @brief Start the commit thread
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool start();
+    
+    /**
+     * @brief Sync pending records and stop the commit thread
+     */
+    void stop();
+    
+    /**
+     * @brief Append a reading
+     * 
+     * Called by the acquisition loop for every reading, before it reaches
+     * the data processor; the caller stores the LSN in
+     * SensorReading::journalLsn. Durable within the sync interval.
+     * 
+     * @param reading Reading to journal
+     * @return LSN of the record, 0 on error
+     */
+    uint64_t append(const Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Append a reading and wait until it is on disk
+     * 
+     * @param reading Reading to journal
+     * @return LSN of the record, 0 on error
+     */
+    uint64_t appendDurable(const Sensors::SensorReading& reading);
+    
+    /**
+     * @brief Mark a range of records as completed
+     * 
+     * Completion means the records no longer need replaying: they were
+     * acknowledged by the broker, sent without acknowledgement (CoAP NON,
+     * MQTT QoS 0), or consumed by the data processor (dropped by a filter
+     * or folded into a journaled aggregate). Failed deliveries are never
+     * completed; their records stay for replay(). Ranges may complete in any
+     * order; each LSN is tracked in a bitmap of JOURNAL_COMPLETION_WINDOW
+     * bits above the checkpoint, and the checkpoint advances to just
+     * below the lowest LSN not yet completed. A checkpoint record is
+     * written with the next group commit, and segments that contain only
+     * completed records are recycled. Completions beyond the window are
+     * counted in JournalStats::untracked and their records are replayed
+     * again after a crash.
+     * 
+     * @param firstLsn First LSN of the range
+     * @param lastLsn Last LSN of the range, inclusive
+     */
+    void complete(uint64_t firstLsn, uint64_t lastLsn);
+    
+    /**
+     * @brief Mark individual records as completed
+     * 
+     * For messages whose readings do not have consecutive LSNs.
+     * 
+     * @param lsns LSNs to complete
+     */
+    void complete(const std::vector<uint64_t>& lsns);
+    
+    /**
+     * @brief Read back records that are still incomplete
+     * 
+     * Used at runtime to resend readings whose delivery failed. Commits
+     * the active buffer first, then reads the records from their
+     * segments. LSNs that were completed meanwhile are skipped; the others
+     * keep their segment from being recycled.
+     * 
+     * @param lsns LSNs to read back
+     * @param replay Callback for each record found
+     * @return Number of records passed to the callback
+     */
+    size_t replay(const std::vector<uint64_t>& lsns, const JournalReplayCallback& replay);
+    
+    /**
+     * @brief Change the sync policy at runtime
+     * 
+     * @param policy New sync policy
+     */
+    void setSyncPolicy(const JournalSyncPolicy& policy);
+    
+    /**
+     * @brief Get the highest LSN assigned so far
+     * 
+     * @return Last LSN
+     */
+    uint64_t getLastLsn() const;
+    
+    /**
+     * @brief Get journal statistics
+     * 
+     * @return Journal statistics
+     */
+    JournalStats getStats() const;
+    
+    /**
+     * @brief Get last error code
+     * 
+     * @return Last error code
+     */
+    System::ErrorCode getLastError() const;
+
+private:
+    std::string mDirectory;
+    JournalSyncPolicy mPolicy;
+    int mSegmentFd;
+    uint32_t mSegmentIndex;
+    uint64_t mSegmentOffset;
+    std::vector<uint8_t> mActiveBuffer;   ///< Records appended since the last commit
+    std::vector<uint8_t> mCommitBuffer;   ///< Records being written by the commit thread
+    std::atomic<uint64_t> mNextLsn;
+    std::atomic<uint64_t> mDurableLsn;
+    std::atomic<uint64_t> mAcknowledgedLsn;  ///< Every LSN up to this one is completed
+    std::vector<uint64_t> mCompleted;        ///< Bit i: LSN mAcknowledgedLsn + 1 + i completed
+    uint64_t mCheckpointedLsn;
+    uint32_t mGeneration;                    ///< Generation of the active segment
+    std::vector<std::pair<uint32_t, uint64_t>> mSegmentLastLsn; ///< Segment index and its last LSN
+    std::thread mCommitThread;
+    std::atomic<bool> mRunning;
+    std::mutex mMutex;
+    std::condition_variable mCommitCondition;
+    std::condition_variable mDurableCondition;
+    JournalStats mStats;
+    System::ErrorCode mLastError;
+    
+    /**
+     * @brief Commit thread loop
+     */
+    void commitLoop();
+    
+    /**
+     * @brief Swap buffers, write and sync them
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool commit();
+    
+    /**
+     * @brief Encode a record into the active buffer
+     * 
+     * @param type Record type
+     * @param lsn Record LSN
+     * @param payload Payload bytes
+     * @param length Payload length
+     */
+    void encodeRecord(JournalRecordType type, uint64_t lsn, const uint8_t* payload, uint16_t length);
+    
+    /**
+     * @brief Switch to the next (preallocated or recycled) segment
+     * 
+     * Writes a JournalSegmentHeader with the next generation and the
+     * next LSN before any record.
+     * 
+     * @return true if successful, false otherwise
+     */
+    bool rollSegment();
+    
+    /**
+     * @brief Advance mAcknowledgedLsn over the completed prefix of the bitmap
+     * 
+     * Shifts the bitmap by the number of LSNs advanced. Called with
+     * mMutex held.
+     */
+    void advanceAcknowledged();
+    
+    /**
+     * @brief Set the last error code
+     * 
+     * @param error Error code
+     */
+    void setLastError(System::ErrorCode error);
+};
+
+} // namespace Storage
+
+#endif // WRITE_AHEAD_JOURNAL_H